@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2025 Ovyl
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file bt_log_xfer.h
+ * @brief Zmod BT log transfer GATT service protocol definitions
+ *
+ * The service streams stored logs from zmod_log_storage_fetch_data(), or the
+ * stored entries from zmod_log_storage_fetch_raw(), as MTU-sized
+ * notifications. The client writes control commands and grants
+ * credits; each credit allows the device to send one block. Every block
+ * carries its offset in the stream and a CRC-32 (IEEE) of its payload, so a
+ * client can detect a bad or missing block and resume from its offset.
+ */
+
+#ifndef ZMOD_BT_LOG_XFER_H
+#define ZMOD_BT_LOG_XFER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <zephyr/bluetooth/uuid.h>
+#include <zephyr/toolchain.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*****************************************************************************
+ * Definitions
+ *****************************************************************************/
+
+/** Log transfer service UUID */
+#define ZMOD_BT_LOG_XFER_SVC_UUID_VAL \
+    BT_UUID_128_ENCODE(0x8f1a0001, 0x6f76, 0x796c, 0x7a6d, 0x6f646c6f6773)
+
+/** Control characteristic UUID (write, write without response) */
+#define ZMOD_BT_LOG_XFER_CTRL_UUID_VAL \
+    BT_UUID_128_ENCODE(0x8f1a0002, 0x6f76, 0x796c, 0x7a6d, 0x6f646c6f6773)
+
+/** Data characteristic UUID (notify) */
+#define ZMOD_BT_LOG_XFER_DATA_UUID_VAL \
+    BT_UUID_128_ENCODE(0x8f1a0003, 0x6f76, 0x796c, 0x7a6d, 0x6f646c6f6773)
+
+/** Block flag: no data remains past this block. */
+#define ZMOD_BT_LOG_XFER_FLAG_END BIT(0)
+/** Block flag: the request failed; the block has no payload. */
+#define ZMOD_BT_LOG_XFER_FLAG_ERROR BIT(1)
+
+/*****************************************************************************
+ * Structs, Unions, Enums, & Typedefs
+ *****************************************************************************/
+
+/**
+ * @brief Control opcodes written to the control characteristic
+ */
+enum zmod_bt_log_xfer_opcode {
+    /**
+     * Start or resume a transfer: u32 offset follows (little-endian), then
+     * an optional u8 zmod_bt_log_xfer_mode (default DATA).
+     * Offset 0 freezes a new export snapshot in the given mode. A non-zero
+     * offset resumes within the current snapshot and keeps its mode; the
+     * snapshot survives a disconnect for
+     * CONFIG_ZMOD_BT_LOG_XFER_RESUME_TIMEOUT_S seconds, and is released
+     * after CONFIG_ZMOD_BT_LOG_XFER_IDLE_TIMEOUT_S seconds without activity.
+     */
+    ZMOD_BT_LOG_XFER_OP_START = 0x01,
+    /** Grant credits: u16 count follows (little-endian). One credit per block. */
+    ZMOD_BT_LOG_XFER_OP_CREDIT = 0x02,
+    /** End the transfer and release the export snapshot. */
+    ZMOD_BT_LOG_XFER_OP_STOP = 0x03,
+};
+
+/**
+ * @brief Stream selected by the START opcode
+ */
+enum zmod_bt_log_xfer_mode {
+    /** Log bytes as returned by zmod_log_storage_fetch_data(), expanded on the device. */
+    ZMOD_BT_LOG_XFER_MODE_DATA = 0,
+    /**
+     * Stored entries as returned by zmod_log_storage_fetch_raw(). Compressed
+     * containers stay compressed, so less is sent and the host expands them
+     * with logging/scripts/log_raw_decode.py.
+     */
+    ZMOD_BT_LOG_XFER_MODE_RAW = 1,
+};
+
+/**
+ * @brief Header at the start of every data notification, followed by @p len payload bytes
+ */
+struct zmod_bt_log_xfer_block_hdr {
+    uint32_t offset; /* Stream offset of the first payload byte */
+    uint16_t len;    /* Payload length in bytes */
+    uint8_t flags;   /* ZMOD_BT_LOG_XFER_FLAG_* */
+    uint8_t status;  /* Negated errno when ZMOD_BT_LOG_XFER_FLAG_ERROR is set, else 0 */
+    uint32_t crc;    /* CRC-32 (IEEE) of the payload */
+} __packed;
+
+/*****************************************************************************
+ * Public Functions
+ *****************************************************************************/
+
+/**
+ * @brief Initialize the log transfer service
+ *
+ * Called by zmod_bt_core_init() before Bluetooth is enabled.
+ */
+void zmod_bt_log_xfer_init(void);
+
+/**
+ * @brief Return true while a log transfer holds an export snapshot
+ *
+ * @return true if a transfer is in progress or waiting to be resumed
+ */
+bool zmod_bt_log_xfer_is_active(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* ZMOD_BT_LOG_XFER_H */
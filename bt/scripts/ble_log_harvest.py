@@ -0,0 +1,253 @@
+#!/usr/bin/env python3
+# Copyright (c) 2025 Ovyl
+# SPDX-License-Identifier: Apache-2.0
+
+"""Harvest stored logs from many units over the Zmod BT log transfer service.
+
+Non-interactive bulk sibling of ble_shell.py and ble_log_xfer.py. Every unit
+whose name matches is connected, its stored entries are downloaded in raw mode
+(compressed containers stay compressed on air) and written to
+<out-dir>/<name>_<address>.raw. A decoder thread per unit unpacks and expands
+the entries with logging/scripts/log_raw_decode.py while the download is still
+running, writing the recovered log stream to <name>_<address>.log.
+
+Units built with CONFIG_ZMOD_LOG_STORAGE_FORMAT_DICTIONARY store binary
+dictionary messages. With --db the recovered stream is written to
+<name>_<address>.dict and decoded into <name>_<address>.log with
+logging/scripts/log_dict_decode.py. Without it, a stream whose containers are
+marked as dictionary data is saved as .dict and left undecoded.
+
+When a transfer starts the device requests an ATT MTU exchange, the 2M PHY and
+the longest data length. CONFIG_ZMOD_BT_LOG_XFER implies the Bluetooth options
+these need.
+"""
+
+import argparse
+import asyncio
+import os
+import queue
+import struct
+import subprocess
+import sys
+import threading
+import time
+
+from bleak import BleakClient, BleakScanner
+
+from ble_log_xfer import (CONNECTION_TIMEOUT_SECONDS, DEFAULT_WINDOW, MAX_CONNECTION_ATTEMPTS,
+                          MODE_DATA, MODE_RAW, RETRY_DELAY_SECONDS, Transfer, run_session)
+
+LOGGING_SCRIPTS = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "..", "logging", "scripts")
+LOG_DICT_DECODE = os.path.join(LOGGING_SCRIPTS, "log_dict_decode.py")
+
+sys.path.insert(0, LOGGING_SCRIPTS)
+from log_raw_decode import FLAG_DICT, decode_entry  # noqa: E402 pylint: disable=wrong-import-position
+
+DEFAULT_SCAN_SECONDS = 10.0
+DEFAULT_JOBS = 2
+
+
+class EntryDecoder(threading.Thread):
+    """Unpack a raw entry stream on a worker thread as blocks arrive."""
+
+    def __init__(self, path):
+        super().__init__(daemon=True)
+        self.out = open(path, "wb")
+        self.chunks = queue.Queue()
+        self.pending = bytearray()
+        self.stored = 0
+        self.expanded = 0
+        self.dictionary = False
+        self.error = None
+
+    def feed(self, data):
+        self.chunks.put(data)
+
+    def finish(self):
+        self.chunks.put(None)
+        self.join()
+        self.out.close()
+        if self.pending and self.error is None:
+            self.error = f"{len(self.pending)} trailing bytes of a truncated entry"
+
+    def run(self):
+        while (data := self.chunks.get()) is not None:
+            if self.error is not None:
+                continue
+            self.pending.extend(data)
+            try:
+                self._drain()
+            except Exception as e:  # pylint: disable=broad-except
+                self.error = str(e)
+
+    def _drain(self):
+        pos = 0
+        while pos + 2 <= len(self.pending):
+            (length,) = struct.unpack_from("<H", self.pending, pos)
+            if pos + 2 + length > len(self.pending):
+                break
+            entry = bytes(self.pending[pos + 2:pos + 2 + length])
+            flags, _, payload = decode_entry(entry)
+            self.dictionary |= bool(flags & FLAG_DICT)
+            self.out.write(payload)
+            self.stored += length
+            self.expanded += len(payload)
+            pos += 2 + length
+        del self.pending[:pos]
+
+
+class Sink:
+    """Write verified payload to the output file and, in raw mode, the decoder."""
+
+    def __init__(self, out, decoder):
+        self.out = out
+        self.decoder = decoder
+
+    def write(self, data):
+        self.out.write(data)
+        if self.decoder is not None:
+            self.decoder.feed(data)
+
+
+async def discover(names, prefix, scan_seconds):
+    """Return the advertising devices selected by name or prefix."""
+    print(f"Scanning for {scan_seconds:.0f} s...")
+    found = await BleakScanner.discover(timeout=scan_seconds)
+    selected = {}
+    for d in found:
+        if not d.name:
+            continue
+        if d.name in names or (prefix and d.name.startswith(prefix)):
+            selected[d.address] = d
+
+    for name in names:
+        if not any(d.name == name for d in selected.values()):
+            print(f"{name}: not found")
+    return sorted(selected.values(), key=lambda d: d.name)
+
+
+def decode_dictionary(src, dst, db, zephyr_base):
+    """Decode a dictionary stream with log_dict_decode.py; return an error or None."""
+    cmd = [sys.executable, LOG_DICT_DECODE, src, "--binary", "--db", db]
+    if zephyr_base:
+        cmd += ["--zephyr-base", zephyr_base]
+
+    with open(dst, "wb") as out:
+        proc = subprocess.run(cmd, stdout=out, stderr=subprocess.PIPE, check=False)
+    if proc.returncode == 0:
+        return None
+    lines = proc.stderr.decode(errors="replace").strip().splitlines()
+    return lines[-1] if lines else f"exit code {proc.returncode}"
+
+
+async def harvest(device, out_dir, window, mode, slots, db, zephyr_base):
+    """Download one unit; return a result row for the summary."""
+    stem = os.path.join(out_dir, f"{device.name}_{device.address.replace(':', '')}")
+    result = {"name": device.name, "address": device.address, "bytes": 0,
+              "logs": 0, "seconds": 0.0, "status": "ok"}
+    stream_path = stem + (".dict" if db else ".log")
+
+    async with slots:
+        out_path = stem + ".raw" if mode == MODE_RAW else stream_path
+        decoder = EntryDecoder(stream_path) if mode == MODE_RAW else None
+        if decoder is not None:
+            decoder.start()
+
+        began = time.monotonic()
+        with open(out_path, "wb") as out:
+            xfer = Transfer(Sink(out, decoder), window, mode)
+            for attempt in range(MAX_CONNECTION_ATTEMPTS):
+                try:
+                    async with BleakClient(device, timeout=CONNECTION_TIMEOUT_SECONDS) as client:
+                        print(f"{device.name}: connected, MTU {client.mtu_size}")
+                        await run_session(client, xfer)
+                        break
+                except RuntimeError as e:
+                    result["status"] = str(e)
+                    break
+                except Exception as e:  # pylint: disable=broad-except
+                    print(f"{device.name}: attempt {attempt + 1} failed at offset {xfer.offset}: {e}")
+                    if attempt == MAX_CONNECTION_ATTEMPTS - 1:
+                        result["status"] = "connection failed"
+                    else:
+                        await asyncio.sleep(RETRY_DELAY_SECONDS)
+
+        result["seconds"] = time.monotonic() - began
+        result["bytes"] = xfer.offset
+        result["logs"] = xfer.offset
+
+        if decoder is not None:
+            await asyncio.get_running_loop().run_in_executor(None, decoder.finish)
+            result["logs"] = decoder.expanded
+            if decoder.error is not None and result["status"] == "ok":
+                result["status"] = f"decode: {decoder.error}"
+            if decoder.dictionary and not db:
+                os.replace(stream_path, stem + ".dict")
+                if result["status"] == "ok":
+                    result["status"] = "ok, dictionary logs in .dict (pass --db to decode)"
+
+        if db and result["status"] == "ok":
+            error = await asyncio.get_running_loop().run_in_executor(
+                None, decode_dictionary, stream_path, stem + ".log", db, zephyr_base)
+            if error is not None:
+                result["status"] = f"dictionary decode: {error}"
+
+    print(f"{device.name}: {result['status']}, {result['bytes']} bytes in {result['seconds']:.1f} s")
+    return result
+
+
+def print_summary(results):
+    print(f"\n{'Unit':<24} {'Address':<18} {'On air':>10} {'Logs':>10} {'KiB/s':>7}  Status")
+    for r in results:
+        rate = r["bytes"] / max(r["seconds"], 1e-6) / 1024
+        print(f"{r['name']:<24} {r['address']:<18} {r['bytes']:>10} {r['logs']:>10} {rate:>7.1f}  {r['status']}")
+
+
+async def run(args):
+    devices = await discover(args.names, args.prefix, args.scan_time)
+    if not devices:
+        sys.exit("No matching devices found")
+
+    os.makedirs(args.out_dir, exist_ok=True)
+    slots = asyncio.Semaphore(max(args.jobs, 1))
+    mode = MODE_DATA if args.expanded else MODE_RAW
+
+    results = await asyncio.gather(*(harvest(d, args.out_dir, max(args.window, 2), mode, slots,
+                                             args.db, args.zephyr_base)
+                                     for d in devices))
+    print_summary(results)
+    return all(r["status"].startswith("ok") for r in results)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Download logs from many Zmod units over BLE")
+    parser.add_argument("names", nargs="*", help="Advertised device names to harvest")
+    parser.add_argument("--prefix", help="Harvest every device whose name starts with this")
+    parser.add_argument("--out-dir", default="logs", help="Output directory (default: logs)")
+    parser.add_argument("--jobs", type=int, default=DEFAULT_JOBS,
+                        help=f"Units downloaded at the same time (default: {DEFAULT_JOBS})")
+    parser.add_argument("--window", type=int, default=DEFAULT_WINDOW,
+                        help=f"Blocks in flight per unit (default: {DEFAULT_WINDOW})")
+    parser.add_argument("--scan-time", type=float, default=DEFAULT_SCAN_SECONDS,
+                        help=f"Scan duration in seconds (default: {DEFAULT_SCAN_SECONDS:.0f})")
+    parser.add_argument("--expanded", action="store_true",
+                        help="Let the device expand compressed entries instead of the host")
+    parser.add_argument("--db",
+                        help="log_dictionary.json of a dictionary-format build; decode each unit's logs")
+    parser.add_argument("--zephyr-base", default=os.environ.get("ZEPHYR_BASE"),
+                        help="Zephyr tree for the dictionary parser (default: $ZEPHYR_BASE)")
+    args = parser.parse_args()
+
+    if not args.names and not args.prefix:
+        parser.error("give device names or --prefix")
+
+    try:
+        ok = asyncio.run(run(args))
+    except KeyboardInterrupt:
+        print("\nInterrupted")
+        ok = False
+    sys.exit(0 if ok else 1)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,185 @@
+#!/usr/bin/env python3
+# Copyright (c) 2025 Ovyl
+# SPDX-License-Identifier: Apache-2.0
+
+"""Download stored logs over the Zmod BT log transfer service.
+
+Requires CONFIG_ZMOD_BT_LOG_XFER on the device. The logs are streamed as
+binary notifications, each block checked against its CRC-32. A bad or missing
+block is requested again from its offset, and a dropped connection is resumed
+where it stopped. The output is the same byte stream that
+zmod_log_storage_fetch_data() returns: text logs, or a dictionary dump for
+logging/scripts/log_dict_decode.py --binary. With --raw the stored entries are
+sent as zmod_log_storage_fetch_raw() returns them, compressed containers
+included; unpack them with logging/scripts/log_raw_decode.py --binary.
+
+To harvest many units at once use ble_log_harvest.py.
+"""
+
+import argparse
+import asyncio
+import struct
+import sys
+import time
+import zlib
+
+from bleak import BleakClient, BleakScanner
+
+LOG_XFER_SVC_UUID = "8f1a0001-6f76-796c-7a6d-6f646c6f6773"
+LOG_XFER_CTRL_UUID = "8f1a0002-6f76-796c-7a6d-6f646c6f6773"  # Write (PC -> device)
+LOG_XFER_DATA_UUID = "8f1a0003-6f76-796c-7a6d-6f646c6f6773"  # Notify (device -> PC)
+
+OP_START = 0x01
+OP_CREDIT = 0x02
+OP_STOP = 0x03
+
+MODE_DATA = 0
+MODE_RAW = 1
+
+FLAG_END = 1 << 0
+FLAG_ERROR = 1 << 1
+
+BLOCK_HDR = struct.Struct("<IHBBI")
+
+SCAN_TIMEOUT_SECONDS = 5.0
+CONNECTION_TIMEOUT_SECONDS = 10.0
+BLOCK_TIMEOUT_SECONDS = 5.0
+MAX_CONNECTION_ATTEMPTS = 3
+RETRY_DELAY_SECONDS = 2.0
+DEFAULT_WINDOW = 32
+
+
+class Transfer:
+    """Reassemble the block stream, tracking the next expected offset."""
+
+    def __init__(self, out, window, mode=MODE_DATA):
+        self.out = out
+        self.window = window
+        self.mode = mode
+        self.offset = 0
+        self.unacked = 0
+        self.done = False
+        self.error = None
+        self.bad_blocks = 0
+        self.events = asyncio.Queue()
+
+    def on_block(self, _, data: bytearray):
+        if len(data) < BLOCK_HDR.size:
+            return
+        offset, length, flags, status, crc = BLOCK_HDR.unpack_from(data)
+        payload = bytes(data[BLOCK_HDR.size:BLOCK_HDR.size + length])
+
+        if flags & FLAG_ERROR:
+            self.error = status
+            self.events.put_nowait("error")
+            return
+
+        self.unacked += 1
+        if offset != self.offset:
+            # A block from before the last restart, or one lost in between.
+            if offset > self.offset:
+                self.bad_blocks += 1
+                self.events.put_nowait("resend")
+            return
+        if len(payload) != length or (zlib.crc32(payload) & 0xFFFFFFFF) != crc:
+            self.bad_blocks += 1
+            self.events.put_nowait("resend")
+            return
+
+        self.out.write(payload)
+        self.offset += length
+        if flags & FLAG_END:
+            self.done = True
+            self.events.put_nowait("end")
+        elif self.unacked >= self.window // 2:
+            self.events.put_nowait("credit")
+
+
+async def find_device(name):
+    print(f"Scanning for '{name}'...")
+    device = await BleakScanner.find_device_by_name(name, timeout=SCAN_TIMEOUT_SECONDS)
+    if device is None:
+        sys.exit(f"Device '{name}' not found")
+    return device
+
+
+async def send(client, op, payload=b"", response=False):
+    await client.write_gatt_char(LOG_XFER_CTRL_UUID, bytes([op]) + payload, response=response)
+
+
+async def start(client, xfer):
+    """Request data from the next expected offset and open the credit window."""
+    xfer.unacked = 0
+    await send(client, OP_START, struct.pack("<IB", xfer.offset, xfer.mode), response=True)
+    await send(client, OP_CREDIT, struct.pack("<H", xfer.window))
+
+
+async def run_session(client, xfer):
+    await client.start_notify(LOG_XFER_DATA_UUID, xfer.on_block)
+    await start(client, xfer)
+
+    while not xfer.done:
+        try:
+            event = await asyncio.wait_for(xfer.events.get(), BLOCK_TIMEOUT_SECONDS)
+        except asyncio.TimeoutError:
+            event = "resend"
+
+        if event == "error":
+            raise RuntimeError(f"Device reported error {-xfer.error} at offset {xfer.offset}")
+        if event == "resend":
+            # Drain stale events so one gap triggers one restart.
+            while not xfer.events.empty():
+                xfer.events.get_nowait()
+            await start(client, xfer)
+        elif event == "credit":
+            granted, xfer.unacked = xfer.unacked, 0
+            await send(client, OP_CREDIT, struct.pack("<H", granted))
+
+    await send(client, OP_STOP, response=True)
+
+
+async def run(name, out_path, window, mode):
+    device = await find_device(name)
+
+    with open(out_path, "wb") as out:
+        xfer = Transfer(out, window, mode)
+        began = time.monotonic()
+
+        for attempt in range(MAX_CONNECTION_ATTEMPTS):
+            try:
+                async with BleakClient(device, timeout=CONNECTION_TIMEOUT_SECONDS) as client:
+                    print(f"Connected to {device.name} ({device.address}), MTU {client.mtu_size}")
+                    await run_session(client, xfer)
+                    break
+            except RuntimeError as e:
+                sys.exit(str(e))
+            except Exception as e:  # pylint: disable=broad-except
+                print(f"Connection attempt {attempt + 1} failed at offset {xfer.offset}: {e}")
+                if attempt == MAX_CONNECTION_ATTEMPTS - 1:
+                    sys.exit("All connection attempts failed")
+                await asyncio.sleep(RETRY_DELAY_SECONDS)
+
+    elapsed = max(time.monotonic() - began, 1e-6)
+    print(f"Saved {xfer.offset} bytes to {out_path} in {elapsed:.1f} s "
+          f"({xfer.offset / elapsed / 1024:.1f} KiB/s, {xfer.bad_blocks} blocks resent)")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Download Zmod logs over the BT log transfer service")
+    parser.add_argument("device_name", help="Advertised device name")
+    parser.add_argument("-o", "--out", default="logs.bin", help="Output file (default: logs.bin)")
+    parser.add_argument("--window", type=int, default=DEFAULT_WINDOW,
+                        help=f"Blocks in flight (default: {DEFAULT_WINDOW})")
+    parser.add_argument("--raw", action="store_true",
+                        help="Download stored entries without expanding them on the device")
+    args = parser.parse_args()
+
+    try:
+        asyncio.run(run(args.device_name, args.out, max(args.window, 2),
+                        MODE_RAW if args.raw else MODE_DATA))
+    except KeyboardInterrupt:
+        print("\nInterrupted")
+
+
+if __name__ == "__main__":
+    main()
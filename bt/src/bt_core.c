@@ -28,6 +28,10 @@
 #include <zephyr/zbus/zbus.h>
 #endif
 
+#ifdef CONFIG_ZMOD_BT_LOG_XFER
+#include <zmod/bt_log_xfer.h>
+#endif
+
 #ifdef CONFIG_ZMOD_BT_SHELL
 #include <bluetooth/services/nus.h>
 #include <shell/shell_bt_nus.h>
@@ -198,6 +202,10 @@ int zmod_bt_core_init(const char *adv_name) {
 
     k_work_init(&prv_inst.advertising_worker, prv_advertising_worker_task);
 
+#ifdef CONFIG_ZMOD_BT_LOG_XFER
+    zmod_bt_log_xfer_init();
+#endif
+
     err = bt_enable(NULL);
     if (err) {
         LOG_ERR("Bluetooth core initialization failed: %d", err);
@@ -0,0 +1,581 @@
+/*
+ * Copyright (c) 2025 Ovyl
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file bt_log_xfer.c
+ * @brief Zmod BT log transfer GATT service
+ *
+ * Streams zmod_log_storage_fetch_data() or zmod_log_storage_fetch_raw()
+ * output as notifications with credit-based flow control. All transfer state is owned by the send work
+ * item on the system work queue; GATT callbacks only post requests to it.
+ */
+
+#include <zmod/bt_log_xfer.h>
+
+#include <errno.h>
+#include <stdbool.h>
+#include <string.h>
+#include <zephyr/bluetooth/bluetooth.h>
+#include <zephyr/bluetooth/conn.h>
+#include <zephyr/bluetooth/gatt.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/crc.h>
+#include <zephyr/sys/util.h>
+
+#include <zmod/log_storage.h>
+
+/*****************************************************************************
+ * Definitions
+ *****************************************************************************/
+
+LOG_MODULE_REGISTER(zmod_bt_log_xfer, CONFIG_ZMOD_BT_LOG_LEVEL);
+
+#define LOG_XFER_HDR_SIZE sizeof(struct zmod_bt_log_xfer_block_hdr)
+#define LOG_XFER_BLOCK_SIZE CONFIG_ZMOD_BT_LOG_XFER_BLOCK_SIZE
+#define LOG_XFER_ATT_OVERHEAD 3U /* ATT opcode and handle in front of every notification */
+#define LOG_XFER_RETRY_MS 10     /* Back-off when the stack is out of TX buffers */
+#define LOG_XFER_RAW_MIN_FETCH 3U /* zmod_log_storage_fetch_raw() needs room past the length */
+
+/* Bits in prv_inst.requests */
+#define LOG_XFER_REQ_START BIT(0)
+#define LOG_XFER_REQ_STOP BIT(1)
+
+static const struct bt_uuid_128 prv_svc_uuid = BT_UUID_INIT_128(ZMOD_BT_LOG_XFER_SVC_UUID_VAL);
+static const struct bt_uuid_128 prv_ctrl_uuid = BT_UUID_INIT_128(ZMOD_BT_LOG_XFER_CTRL_UUID_VAL);
+static const struct bt_uuid_128 prv_data_uuid = BT_UUID_INIT_128(ZMOD_BT_LOG_XFER_DATA_UUID_VAL);
+
+/*****************************************************************************
+ * Variables
+ *****************************************************************************/
+
+/**
+ * @brief Private static instance
+ */
+static struct {
+    struct k_work_delayable send_work;   /* Builds and sends blocks while credits last */
+    struct k_work_delayable expire_work; /* Releases the snapshot after a disconnect or when idle */
+    struct k_mutex conn_lock;            /* Guards conn between the BT and work queue threads */
+    struct bt_conn *conn;                /* Peer that started the transfer */
+    struct bt_gatt_notify_params notify_params;
+#ifdef CONFIG_BT_GATT_CLIENT
+    struct bt_gatt_exchange_params mtu_params;
+    atomic_t mtu_busy;                   /* An MTU exchange is in flight with mtu_params */
+#endif
+    atomic_t requests;                   /* LOG_XFER_REQ_* posted by the control handler */
+    atomic_t credits;                    /* Blocks the client is ready to receive */
+    uint32_t start_offset;               /* Offset of the latest START request */
+    uint8_t start_mode;                  /* zmod_bt_log_xfer_mode of the latest START request */
+    bool raw;                            /* Session streams stored entries, not log bytes */
+    uint8_t carry_len;                   /* Bytes read past a seek target, left at the payload start */
+    bool notify_enabled;                 /* Client subscribed to the data characteristic */
+    bool active;                         /* Export snapshot held */
+    bool pending;                        /* block holds an unsent notification */
+    bool end_sent;                       /* END or ERROR block sent; wait for the client */
+    uint32_t offset;                     /* Stream offset of the next unread byte */
+    uint16_t pending_len;                /* Bytes in block, header included */
+    uint8_t block[LOG_XFER_HDR_SIZE + LOG_XFER_BLOCK_SIZE];
+} prv_inst;
+
+/*****************************************************************************
+ * Prototypes
+ *****************************************************************************/
+
+static ssize_t prv_ctrl_write(struct bt_conn *conn,
+                              const struct bt_gatt_attr *attr,
+                              const void *buf,
+                              uint16_t len,
+                              uint16_t offset,
+                              uint8_t flags);
+static void prv_data_ccc_changed(const struct bt_gatt_attr *attr, uint16_t value);
+static void prv_send_work_handler(struct k_work *work);
+static void prv_expire_work_handler(struct k_work *work);
+
+BT_GATT_SERVICE_DEFINE(prv_log_xfer_svc,
+                       BT_GATT_PRIMARY_SERVICE(&prv_svc_uuid),
+                       BT_GATT_CHARACTERISTIC(&prv_ctrl_uuid.uuid,
+                                              BT_GATT_CHRC_WRITE | BT_GATT_CHRC_WRITE_WITHOUT_RESP,
+                                              BT_GATT_PERM_WRITE,
+                                              NULL,
+                                              prv_ctrl_write,
+                                              NULL),
+                       BT_GATT_CHARACTERISTIC(&prv_data_uuid.uuid,
+                                              BT_GATT_CHRC_NOTIFY,
+                                              BT_GATT_PERM_NONE,
+                                              NULL,
+                                              NULL,
+                                              NULL),
+                       BT_GATT_CCC(prv_data_ccc_changed, BT_GATT_PERM_READ | BT_GATT_PERM_WRITE));
+
+/* Value attribute of the data characteristic */
+#define LOG_XFER_DATA_ATTR (&prv_log_xfer_svc.attrs[4])
+
+/*****************************************************************************
+ * Public Functions
+ *****************************************************************************/
+
+void zmod_bt_log_xfer_init(void) {
+    k_mutex_init(&prv_inst.conn_lock);
+    k_work_init_delayable(&prv_inst.send_work, prv_send_work_handler);
+    k_work_init_delayable(&prv_inst.expire_work, prv_expire_work_handler);
+}
+
+bool zmod_bt_log_xfer_is_active(void) {
+    return prv_inst.active;
+}
+
+/*****************************************************************************
+ * Private Functions
+ *****************************************************************************/
+
+/**
+ * @brief Write a block header in front of @p len payload bytes already in the block
+ */
+static void prv_block_finish(uint16_t len, uint8_t flags, int status) {
+    uint8_t *hdr = prv_inst.block;
+
+    sys_put_le32(prv_inst.offset - len, &hdr[offsetof(struct zmod_bt_log_xfer_block_hdr, offset)]);
+    sys_put_le16(len, &hdr[offsetof(struct zmod_bt_log_xfer_block_hdr, len)]);
+    hdr[offsetof(struct zmod_bt_log_xfer_block_hdr, flags)] = flags;
+    hdr[offsetof(struct zmod_bt_log_xfer_block_hdr, status)] = (uint8_t)MIN(-status, UINT8_MAX);
+    sys_put_le32(crc32_ieee(&prv_inst.block[LOG_XFER_HDR_SIZE], len),
+                 &hdr[offsetof(struct zmod_bt_log_xfer_block_hdr, crc)]);
+
+    prv_inst.pending_len = LOG_XFER_HDR_SIZE + len;
+    prv_inst.pending = true;
+    prv_inst.end_sent = (flags != 0U);
+}
+
+/**
+ * @brief Queue an error block reporting @p err to the client
+ */
+static void prv_block_error(int err) {
+    LOG_WRN("Log transfer failed at offset %u: %d", prv_inst.offset, err);
+    prv_block_finish(0U, ZMOD_BT_LOG_XFER_FLAG_ERROR, err);
+}
+
+/**
+ * @brief Read the next bytes of the session's stream into @p dst
+ *
+ * Raw reads need room for an entry length prefix, so they may return more
+ * than @p want when it is that small.
+ */
+static int prv_fetch(uint8_t *dst, size_t want, size_t dst_size, size_t *out) {
+    if (prv_inst.raw) {
+        return zmod_log_storage_fetch_raw(dst, MIN(MAX(want, LOG_XFER_RAW_MIN_FETCH), dst_size), out);
+    }
+
+    return zmod_log_storage_fetch_data(dst, want, out);
+}
+
+/**
+ * @brief Fill the block with up to @p max_len bytes of log data
+ *
+ * @retval 0 A block is pending.
+ * @retval -EBUSY Storage is busy; try again later.
+ */
+static int prv_block_fill(size_t max_len) {
+    uint8_t *payload = &prv_inst.block[LOG_XFER_HDR_SIZE];
+    size_t len = prv_inst.carry_len;
+    size_t min_fetch = prv_inst.raw ? LOG_XFER_RAW_MIN_FETCH : 1U;
+    int ret = 0;
+
+    prv_inst.carry_len = 0U;
+
+    while ((len + min_fetch) <= max_len) {
+        size_t out = 0U;
+
+        ret = prv_fetch(&payload[len], max_len - len, max_len - len, &out);
+        if (ret < 0) {
+            break;
+        }
+        len += out;
+        prv_inst.offset += out;
+    }
+
+    if (ret == -ENOENT) {
+        prv_block_finish(len, ZMOD_BT_LOG_XFER_FLAG_END, 0);
+    } else if ((ret == 0) || (len > 0U)) {
+        /* A short read is sent as is; a persistent error surfaces on the next block. */
+        prv_block_finish(len, 0U, 0);
+    } else if (ret == -EBUSY) {
+        return ret;
+    } else {
+        /* -ESTALE included: the stream lost data and offsets no longer line up. */
+        prv_block_error(ret);
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Move the read position to @p offset within the current snapshot
+ *
+ * A raw read can end past @p offset; the surplus is kept as the start of the
+ * next block.
+ */
+static int prv_seek(uint32_t offset) {
+    uint8_t *payload = &prv_inst.block[LOG_XFER_HDR_SIZE];
+
+    prv_inst.carry_len = 0U;
+
+    if (offset < prv_inst.offset) {
+        zmod_log_storage_reset_read();
+        prv_inst.offset = 0U;
+    }
+
+    while (prv_inst.offset < offset) {
+        size_t out = 0U;
+        size_t want = MIN(offset - prv_inst.offset, LOG_XFER_BLOCK_SIZE);
+
+        int ret = prv_fetch(payload, want, LOG_XFER_BLOCK_SIZE, &out);
+        if (ret == -ENOENT) {
+            return -ERANGE;
+        }
+        if (ret < 0) {
+            return ret;
+        }
+        prv_inst.offset += out;
+
+        if (prv_inst.offset > offset) {
+            prv_inst.carry_len = prv_inst.offset - offset;
+            memmove(payload, &payload[out - prv_inst.carry_len], prv_inst.carry_len);
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Release the export snapshot and forget the transfer position
+ */
+static void prv_session_end(void) {
+    if (prv_inst.active) {
+        zmod_log_storage_set_export_in_progress(false);
+        LOG_INF("Log transfer ended at offset %u", prv_inst.offset);
+    }
+
+    prv_inst.active = false;
+    prv_inst.pending = false;
+    prv_inst.end_sent = false;
+    prv_inst.offset = 0U;
+    prv_inst.carry_len = 0U;
+}
+
+#ifdef CONFIG_BT_GATT_CLIENT
+/**
+ * @brief MTU exchange finished; blocks sent from now on fill the new MTU
+ */
+static void prv_mtu_exchanged(struct bt_conn *conn, uint8_t err, struct bt_gatt_exchange_params *params) {
+    ARG_UNUSED(params);
+
+    LOG_DBG("MTU exchange %s, MTU %u", (err == 0U) ? "done" : "failed", bt_gatt_get_mtu(conn));
+    atomic_clear(&prv_inst.mtu_busy);
+}
+#endif
+
+/**
+ * @brief Ask for the fastest link the peer supports before a new transfer
+ *
+ * All requests are best effort; the peer may refuse them. They need
+ * CONFIG_BT_GATT_CLIENT, CONFIG_BT_USER_PHY_UPDATE and
+ * CONFIG_BT_USER_DATA_LEN_UPDATE, which CONFIG_ZMOD_BT_LOG_XFER implies.
+ */
+static void prv_link_tune(void) {
+#if defined(CONFIG_BT_GATT_CLIENT) || defined(CONFIG_BT_USER_PHY_UPDATE) ||                      \
+    defined(CONFIG_BT_USER_DATA_LEN_UPDATE)
+    k_mutex_lock(&prv_inst.conn_lock, K_FOREVER);
+    struct bt_conn *conn = (prv_inst.conn != NULL) ? bt_conn_ref(prv_inst.conn) : NULL;
+    k_mutex_unlock(&prv_inst.conn_lock);
+
+    if (conn == NULL) {
+        return;
+    }
+
+    int ret;
+
+#ifdef CONFIG_BT_GATT_CLIENT
+    /* Only one exchange per connection is allowed; a repeat fails harmlessly. */
+    if (atomic_cas(&prv_inst.mtu_busy, 0, 1)) {
+        prv_inst.mtu_params.func = prv_mtu_exchanged;
+        ret = bt_gatt_exchange_mtu(conn, &prv_inst.mtu_params);
+        if (ret < 0) {
+            LOG_DBG("MTU exchange request failed: %d", ret);
+            atomic_clear(&prv_inst.mtu_busy);
+        }
+    }
+#endif
+#ifdef CONFIG_BT_USER_PHY_UPDATE
+    ret = bt_conn_le_phy_update(conn, BT_CONN_LE_PHY_PARAM_2M);
+    if (ret < 0) {
+        LOG_DBG("2M PHY request failed: %d", ret);
+    }
+#endif
+#ifdef CONFIG_BT_USER_DATA_LEN_UPDATE
+    ret = bt_conn_le_data_len_update(conn, BT_LE_DATA_LEN_PARAM_MAX);
+    if (ret < 0) {
+        LOG_DBG("Data length update failed: %d", ret);
+    }
+#endif
+
+    bt_conn_unref(conn);
+#endif
+}
+
+/**
+ * @brief Push back the idle timeout while the transfer peer is connected
+ *
+ * A client that stops granting credits or never sends STOP would otherwise
+ * hold the snapshot, and logs written once the ring fills would be dropped.
+ * After a disconnect the resume timeout applies instead.
+ */
+static void prv_idle_arm(void) {
+    k_mutex_lock(&prv_inst.conn_lock, K_FOREVER);
+    bool connected = (prv_inst.conn != NULL);
+    k_mutex_unlock(&prv_inst.conn_lock);
+
+    if (prv_inst.active && connected) {
+        (void)k_work_reschedule(&prv_inst.expire_work, K_SECONDS(CONFIG_ZMOD_BT_LOG_XFER_IDLE_TIMEOUT_S));
+    }
+}
+
+/**
+ * @brief Handle a START request: a new snapshot at offset 0, otherwise a resume
+ */
+static void prv_session_start(uint32_t offset, uint8_t mode) {
+    (void)k_work_cancel_delayable(&prv_inst.expire_work);
+    prv_inst.pending = false;
+    prv_inst.end_sent = false;
+
+    if (offset == 0U) {
+        prv_session_end();
+        zmod_log_storage_set_export_in_progress(true);
+        zmod_log_storage_reset_read();
+        prv_inst.active = true;
+        prv_inst.raw = (mode == ZMOD_BT_LOG_XFER_MODE_RAW);
+        prv_link_tune();
+        LOG_INF("Log transfer started%s", prv_inst.raw ? " (raw)" : "");
+        return;
+    }
+
+    if (!prv_inst.active) {
+        prv_block_error(-ENOENT);
+        return;
+    }
+
+    int ret = prv_seek(offset);
+    if (ret < 0) {
+        prv_block_error(ret);
+        return;
+    }
+
+    LOG_INF("Log transfer resumed at offset %u", offset);
+}
+
+/**
+ * @brief Notification sent; more TX buffers may be free
+ */
+static void prv_notify_sent(struct bt_conn *conn, void *user_data) {
+    ARG_UNUSED(conn);
+    ARG_UNUSED(user_data);
+
+    (void)k_work_schedule(&prv_inst.send_work, K_NO_WAIT);
+}
+
+/**
+ * @brief Process requests, then send blocks while the client has credits
+ *
+ * @param work Pointer to work instance
+ */
+static void prv_send_work_handler(struct k_work *work) {
+    ARG_UNUSED(work);
+
+    atomic_val_t requests = atomic_clear(&prv_inst.requests);
+
+    if ((requests & LOG_XFER_REQ_STOP) != 0) {
+        prv_session_end();
+    }
+    if ((requests & LOG_XFER_REQ_START) != 0) {
+        prv_session_start(prv_inst.start_offset, prv_inst.start_mode);
+    }
+
+    /* Requests and sent notifications both count as activity. */
+    prv_idle_arm();
+
+    while ((prv_inst.active || prv_inst.pending) && (atomic_get(&prv_inst.credits) > 0)) {
+        k_mutex_lock(&prv_inst.conn_lock, K_FOREVER);
+        struct bt_conn *conn = (prv_inst.conn != NULL) ? bt_conn_ref(prv_inst.conn) : NULL;
+        bool notify_enabled = prv_inst.notify_enabled;
+        k_mutex_unlock(&prv_inst.conn_lock);
+
+        if (conn == NULL) {
+            return;
+        }
+        if (!notify_enabled) {
+            bt_conn_unref(conn);
+            return;
+        }
+
+        if (!prv_inst.pending) {
+            if (prv_inst.end_sent) {
+                bt_conn_unref(conn);
+                return;
+            }
+
+            size_t max_len = bt_gatt_get_mtu(conn) - LOG_XFER_ATT_OVERHEAD - LOG_XFER_HDR_SIZE;
+
+            if (prv_block_fill(MIN(max_len, LOG_XFER_BLOCK_SIZE)) < 0) {
+                bt_conn_unref(conn);
+                (void)k_work_schedule(&prv_inst.send_work, K_MSEC(LOG_XFER_RETRY_MS));
+                return;
+            }
+        }
+
+        prv_inst.notify_params.attr = LOG_XFER_DATA_ATTR;
+        prv_inst.notify_params.data = prv_inst.block;
+        prv_inst.notify_params.len = prv_inst.pending_len;
+        prv_inst.notify_params.func = prv_notify_sent;
+
+        int ret = bt_gatt_notify_cb(conn, &prv_inst.notify_params);
+        bt_conn_unref(conn);
+
+        if (ret == -ENOMEM) {
+            /* Out of TX buffers; keep the block and retry once one frees up. */
+            (void)k_work_schedule(&prv_inst.send_work, K_MSEC(LOG_XFER_RETRY_MS));
+            return;
+        }
+        if (ret < 0) {
+            LOG_WRN("Failed to send log block: %d", ret);
+            return;
+        }
+
+        prv_inst.pending = false;
+        atomic_dec(&prv_inst.credits);
+    }
+}
+
+/**
+ * @brief Release the snapshot if the client did not resume in time, or went idle
+ *
+ * @param work Pointer to work instance
+ */
+static void prv_expire_work_handler(struct k_work *work) {
+    ARG_UNUSED(work);
+
+    if (prv_inst.active) {
+        LOG_INF("Log transfer idle or not resumed; releasing snapshot");
+    }
+    prv_session_end();
+}
+
+/**
+ * @brief Take a reference to @p conn as the transfer peer, dropping any previous one
+ */
+static void prv_conn_set(struct bt_conn *conn) {
+    k_mutex_lock(&prv_inst.conn_lock, K_FOREVER);
+    if (prv_inst.conn != conn) {
+        if (prv_inst.conn != NULL) {
+            bt_conn_unref(prv_inst.conn);
+        }
+        prv_inst.conn = (conn != NULL) ? bt_conn_ref(conn) : NULL;
+    }
+    k_mutex_unlock(&prv_inst.conn_lock);
+}
+
+/**
+ * @brief Control characteristic write handler
+ */
+static ssize_t prv_ctrl_write(struct bt_conn *conn,
+                              const struct bt_gatt_attr *attr,
+                              const void *buf,
+                              uint16_t len,
+                              uint16_t offset,
+                              uint8_t flags) {
+    ARG_UNUSED(attr);
+    ARG_UNUSED(flags);
+
+    const uint8_t *cmd = buf;
+
+    if ((offset != 0U) || (len < 1U)) {
+        return BT_GATT_ERR(BT_ATT_ERR_INVALID_ATTRIBUTE_LEN);
+    }
+
+    switch (cmd[0]) {
+    case ZMOD_BT_LOG_XFER_OP_START:
+        if ((len != 5U) && (len != 6U)) {
+            return BT_GATT_ERR(BT_ATT_ERR_INVALID_ATTRIBUTE_LEN);
+        }
+        if ((len == 6U) && (cmd[5] > ZMOD_BT_LOG_XFER_MODE_RAW)) {
+            return BT_GATT_ERR(BT_ATT_ERR_NOT_SUPPORTED);
+        }
+        prv_conn_set(conn);
+        prv_inst.start_offset = sys_get_le32(&cmd[1]);
+        prv_inst.start_mode = (len == 6U) ? cmd[5] : ZMOD_BT_LOG_XFER_MODE_DATA;
+        /* Credits granted before the restart refer to the old stream. */
+        atomic_set(&prv_inst.credits, 0);
+        atomic_or(&prv_inst.requests, LOG_XFER_REQ_START);
+        break;
+    case ZMOD_BT_LOG_XFER_OP_CREDIT:
+        if (len != 3U) {
+            return BT_GATT_ERR(BT_ATT_ERR_INVALID_ATTRIBUTE_LEN);
+        }
+        atomic_add(&prv_inst.credits, sys_get_le16(&cmd[1]));
+        break;
+    case ZMOD_BT_LOG_XFER_OP_STOP:
+        atomic_set(&prv_inst.credits, 0);
+        atomic_or(&prv_inst.requests, LOG_XFER_REQ_STOP);
+        break;
+    default:
+        return BT_GATT_ERR(BT_ATT_ERR_NOT_SUPPORTED);
+    }
+
+    prv_idle_arm();
+    (void)k_work_schedule(&prv_inst.send_work, K_NO_WAIT);
+    return len;
+}
+
+/**
+ * @brief Data characteristic CCC changed
+ */
+static void prv_data_ccc_changed(const struct bt_gatt_attr *attr, uint16_t value) {
+    ARG_UNUSED(attr);
+
+    k_mutex_lock(&prv_inst.conn_lock, K_FOREVER);
+    prv_inst.notify_enabled = (value == BT_GATT_CCC_NOTIFY);
+    k_mutex_unlock(&prv_inst.conn_lock);
+
+    (void)k_work_schedule(&prv_inst.send_work, K_NO_WAIT);
+}
+
+/**
+ * @brief Callback called when device disconnected
+ *
+ * @param conn Pointer to connection
+ * @param reason Reason for disconnection
+ */
+static void prv_device_disconnected(struct bt_conn *conn, uint8_t reason) {
+    ARG_UNUSED(reason);
+
+    k_mutex_lock(&prv_inst.conn_lock, K_FOREVER);
+    bool ours = (prv_inst.conn == conn);
+    k_mutex_unlock(&prv_inst.conn_lock);
+
+    if (!ours) {
+        return;
+    }
+
+    prv_conn_set(NULL);
+    atomic_set(&prv_inst.credits, 0);
+
+    /* Keep the snapshot for a while so the client can reconnect and resume. */
+    (void)k_work_reschedule(&prv_inst.expire_work, K_SECONDS(CONFIG_ZMOD_BT_LOG_XFER_RESUME_TIMEOUT_S));
+}
+
+BT_CONN_CB_DEFINE(log_xfer_conn_callbacks) = {
+    .disconnected = prv_device_disconnected,
+};
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2025 Ovyl
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file config_accessors.h
+ * @brief Typed configuration accessors generated from the app's .def file
+ *
+ * For every CFG_DEFINE(key, type, ...) entry this defines
+ * zmod_cfg_get_<key>(type *value) and zmod_cfg_set_<key>(const type *value).
+ * The size passed to the config manager is sizeof(type), so a buffer of the
+ * wrong type is a compile error instead of a runtime assert.
+ */
+
+#ifndef ZMOD_CONFIG_ACCESSORS_H
+#define ZMOD_CONFIG_ACCESSORS_H
+
+#include <zmod/config_mgr.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef CONFIG_ZMOD_CONFIG_USE_CUSTOM_TYPES
+#include CONFIG_ZMOD_CONFIG_TYPES_DEF_PATH
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*****************************************************************************
+ * Definitions
+ *****************************************************************************/
+
+#ifdef CONFIG_ZMOD_CONFIG_CACHE
+#define ZMOD_CFG_ACCESSOR_READ zmod_config_mgr_get_cached
+#else
+#define ZMOD_CFG_ACCESSOR_READ zmod_config_mgr_get_value
+#endif
+
+/*****************************************************************************
+ * Public Functions
+ *****************************************************************************/
+
+#define CFG_DEFINE(key, type, default_val, rst)                                                    \
+    static inline bool zmod_cfg_get_##key(type *value) {                                           \
+        return ZMOD_CFG_ACCESSOR_READ(key, value, sizeof(type));                                   \
+    }                                                                                              \
+    static inline bool zmod_cfg_set_##key(const type *value) {                                     \
+        return zmod_config_mgr_set_value(key, value, sizeof(type));                                \
+    }
+#include CONFIG_ZMOD_CONFIG_APP_DEF_PATH
+#undef CFG_DEFINE
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* ZMOD_CONFIG_ACCESSORS_H */
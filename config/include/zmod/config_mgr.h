@@ -29,6 +29,29 @@ extern "C" {
  * Structs, Unions, Enums, & Typedefs
  *****************************************************************************/
 
+/**
+ * @brief Config change event
+ *
+ * Published on zmod_config_changed_chan after a set, a reset to the default
+ * or a transaction commit changes the value of a key.
+ */
+struct zmod_config_changed_event {
+    config_key_t key; /* Key whose value changed */
+    size_t size;      /* Size of the value in bytes */
+};
+
+#ifdef CONFIG_ZMOD_CONFIG_ZBUS_PUBLISH
+/* Zbus channel for config change events */
+ZBUS_CHAN_DECLARE(zmod_config_changed_chan);
+#endif
+
+#ifdef CONFIG_ZMOD_CONFIG_ZBUS_KEY_CHANNELS
+/* One Zbus channel per key, zmod_cfg_<key>_chan, carrying the new value */
+#define CFG_DEFINE(key, type, default_val, rst) ZBUS_CHAN_DECLARE(zmod_cfg_##key##_chan);
+#include CONFIG_ZMOD_CONFIG_APP_DEF_PATH
+#undef CFG_DEFINE
+#endif
+
 /*****************************************************************************
  * Public Functions
  *****************************************************************************/
@@ -48,9 +71,28 @@ void zmod_config_mgr_init(void);
  */
 bool zmod_config_mgr_get_value(config_key_t key, void *dst, size_t size);
 
+#ifdef CONFIG_ZMOD_CONFIG_CACHE
+/**
+ * @brief Get value of configuration for key from the RAM cache, unchecked
+ *
+ * Fast path for the generated accessors in config_accessors.h, which pass
+ * the exact size of the key's type. The size is not validated. Falls back
+ * to zmod_config_mgr_get_value() for a key that is not cached.
+ *
+ * @param key Key
+ * @param dst Buffer to write value to
+ * @param size Size of the key's value
+ * @return Returns false if the key is out of range or cannot be read
+ */
+bool zmod_config_mgr_get_cached(config_key_t key, void *dst, size_t size);
+#endif
+
 /**
  * @brief Set value for given key
  *
+ * With CONFIG_ZMOD_CONFIG_WRITE_BACK the value is only stored in RAM and
+ * written to NVS by a later commit; see zmod_config_mgr_commit().
+ *
  * @param key Key
  * @param src Source buffer
  * @param size Size of source
@@ -58,6 +100,64 @@ bool zmod_config_mgr_get_value(config_key_t key, void *dst, size_t size);
  */
 bool zmod_config_mgr_set_value(config_key_t key, const void *src, size_t size);
 
+/**
+ * @brief Write pending values to NVS now
+ *
+ * With CONFIG_ZMOD_CONFIG_WRITE_BACK, sets are committed in the background
+ * once no key has changed for CONFIG_ZMOD_CONFIG_WRITE_BACK_DELAY_MS. Call
+ * this before sys_reboot(), on low battery, or wherever a value must be in
+ * flash before continuing. Blocks for the NVS writes. Keys that fail to write
+ * stay pending and are retried in the background.
+ *
+ * @return Returns true if nothing is left pending. Always true without
+ * write-back.
+ */
+bool zmod_config_mgr_commit(void);
+
+#ifdef CONFIG_ZMOD_CONFIG_TXN
+/**
+ * @brief Open a transaction for a group of keys that must change together
+ *
+ * Only one transaction is open at a time; another thread calling this
+ * blocks until the current one is committed or aborted. Values staged with
+ * zmod_config_mgr_txn_set() are invisible to zmod_config_mgr_get_value(),
+ * including from the owning thread, until the commit.
+ *
+ * @return Returns false if the calling thread already has a transaction open
+ */
+bool zmod_config_mgr_txn_begin(void);
+
+/**
+ * @brief Stage a value in the calling thread's open transaction
+ *
+ * @param key Key
+ * @param src Source buffer
+ * @param size Size of source
+ * @return Returns false if no transaction is open in this thread or the key is invalid
+ */
+bool zmod_config_mgr_txn_set(config_key_t key, const void *src, size_t size);
+
+/**
+ * @brief Commit the staged values as one unit and close the transaction
+ *
+ * The group costs one NVS write: the journal record, rewritten with the
+ * staged values added, is the commit point, and readers then see every
+ * staged value at once. The journal overrides the per-key records at
+ * zmod_config_mgr_init(), so the group survives a reset whole. A key leaves
+ * the journal when it is next set or reset on its own, which costs one more
+ * journal rewrite.
+ *
+ * @return Returns true if the group was committed. On failure nothing is
+ * applied; the transaction is closed either way.
+ */
+bool zmod_config_mgr_txn_commit(void);
+
+/**
+ * @brief Discard the staged values and close the transaction
+ */
+void zmod_config_mgr_txn_abort(void);
+#endif
+
 /**
  * @brief Reset all NVS entries to defaults
  *
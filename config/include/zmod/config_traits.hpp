@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2025 Ovyl
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file config_traits.hpp
+ * @brief Compile-time configuration key traits for C++
+ *
+ * zmod::config::traits<Key> exposes the value type and size of every
+ * CFG_DEFINE entry as constexpr members, and zmod::config::get<Key>() /
+ * set<Key>() use them, so the size is fixed at compile time and a value of
+ * the wrong type does not compile:
+ *
+ * @code
+ * uint16_t rate = zmod::config::get<SAMPLE_RATE>();
+ * zmod::config::set<SAMPLE_RATE>(2000);
+ * @endcode
+ */
+
+#ifndef ZMOD_CONFIG_TRAITS_HPP
+#define ZMOD_CONFIG_TRAITS_HPP
+
+#include <zmod/config_accessors.h>
+
+#include <stddef.h>
+
+namespace zmod {
+namespace config {
+
+/**
+ * @brief Traits of a configuration key, specialized for every .def entry
+ */
+template <config_key_t Key> struct traits;
+
+#define CFG_DEFINE(key, type, default_val, rst)                                                    \
+    template <> struct traits<key> {                                                               \
+        using value_type = type;                                                                   \
+        static constexpr config_key_t id = key;                                                    \
+        static constexpr size_t size = sizeof(type);                                               \
+        static constexpr bool resettable = (rst);                                                  \
+    };
+#include CONFIG_ZMOD_CONFIG_APP_DEF_PATH
+#undef CFG_DEFINE
+
+/**
+ * @brief Read the value of Key
+ *
+ * Served from the RAM cache without an entry lookup when
+ * CONFIG_ZMOD_CONFIG_CACHE is enabled.
+ *
+ * @return Returns true on success
+ */
+template <config_key_t Key> inline bool get(typename traits<Key>::value_type &value) {
+    return ZMOD_CFG_ACCESSOR_READ(Key, &value, traits<Key>::size);
+}
+
+/**
+ * @brief Return the value of Key, value-initialized if it cannot be read
+ */
+template <config_key_t Key> inline typename traits<Key>::value_type get() {
+    typename traits<Key>::value_type value{};
+
+    (void)get<Key>(value);
+
+    return value;
+}
+
+/**
+ * @brief Set the value of Key
+ *
+ * @return Returns true on success
+ */
+template <config_key_t Key> inline bool set(const typename traits<Key>::value_type &value) {
+    return zmod_config_mgr_set_value(Key, &value, traits<Key>::size);
+}
+
+} // namespace config
+} // namespace zmod
+
+#endif /* ZMOD_CONFIG_TRAITS_HPP */
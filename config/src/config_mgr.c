@@ -11,6 +11,7 @@
 
 #include <zmod/config_mgr.h>
 
+#include <zephyr/kernel.h>
 #include <zephyr/sys/__assert.h>
 #include <zephyr/fs/nvs.h>
 #include <zephyr/drivers/flash.h>
@@ -26,6 +27,14 @@
 
 #include <zmod/config_version.h>
 
+#ifdef CONFIG_ZMOD_CONFIG_USE_CUSTOM_TYPES
+#include CONFIG_ZMOD_CONFIG_TYPES_DEF_PATH
+#endif
+
+#ifdef CONFIG_ZMOD_CONFIG_WRITE_BACK_IWDOG_FLUSH
+#include <zmod/iwdog.h>
+#endif
+
 /*****************************************************************************
  * Definitions
  *****************************************************************************/
@@ -34,23 +43,161 @@ LOG_MODULE_REGISTER(zmod_cfg_mgr, CONFIG_ZMOD_CFG_MGR_LOG_LEVEL);
 
 #define CFG_OPT_FLASH_AREA nvs_storage
 
+#ifdef CONFIG_ZMOD_CONFIG_ZBUS_PUBLISH
+/* Define the Zbus channel for config changes */
+ZBUS_CHAN_DEFINE(zmod_config_changed_chan,
+                 struct zmod_config_changed_event,
+                 NULL,
+                 NULL,
+                 ZBUS_OBSERVERS_EMPTY,
+                 ZBUS_MSG_INIT(0));
+#endif
+
+#ifdef CONFIG_ZMOD_CONFIG_ZBUS_KEY_CHANNELS
+// One channel per key, carrying the key's new value
+#define CFG_DEFINE(key, type, default_val, rst)                                                    \
+    ZBUS_CHAN_DEFINE(zmod_cfg_##key##_chan, type, NULL, NULL, ZBUS_OBSERVERS_EMPTY, ZBUS_MSG_INIT(0));
+#include CONFIG_ZMOD_CONFIG_APP_DEF_PATH
+#undef CFG_DEFINE
+#endif
+
+#ifdef CONFIG_ZMOD_CONFIG_CACHE
+// One member per key, each with the exact type from the .def file
+#define CFG_DEFINE(key, type, default_val, rst) type key;
+typedef struct {
+#include CONFIG_ZMOD_CONFIG_APP_DEF_PATH
+} prv_cache_values_t;
+
+// Large enough for any single value
+typedef union {
+#include CONFIG_ZMOD_CONFIG_APP_DEF_PATH
+} prv_value_buf_t;
+#undef CFG_DEFINE
+#endif
+
+#ifdef CONFIG_ZMOD_CONFIG_WRITE_BACK
+#define CFG_WRITE_BACK_DELAY_MS CONFIG_ZMOD_CONFIG_WRITE_BACK_DELAY_MS
+#define CFG_WRITE_BACK_MAX_DELAY_MS CONFIG_ZMOD_CONFIG_WRITE_BACK_MAX_DELAY_MS
+
+BUILD_ASSERT(CFG_WRITE_BACK_DELAY_MS <= CFG_WRITE_BACK_MAX_DELAY_MS,
+             "Write-back quiet period must not exceed the maximum delay");
+#endif
+
+#ifdef CONFIG_ZMOD_CONFIG_CACHE
+// NVS writes that must stay ordered against each other or the cache take commit_lock
+// (write-back and transactions select the cache)
+#define CFG_COMMIT_LOCK
+#endif
+
+#ifdef CONFIG_ZMOD_CONFIG_TXN
+// NVS ID of the transaction journal, clear of the key IDs
+#define CFG_TXN_JOURNAL_ID (0xFFFEU)
+
+/**
+ * @brief Journal entry header, followed by len value bytes
+ *
+ * The journal is a uint16_t entry count followed by the entries. It holds the
+ * current value of every key committed by a transaction and not written to
+ * its own record since, and overrides those records at init.
+ */
+typedef struct __packed {
+    uint16_t key;
+    uint16_t len;
+} prv_journal_entry_t;
+
+#define CFG_TXN_JOURNAL_SIZE                                                                       \
+    (sizeof(uint16_t) + sizeof(prv_cache_values_t) + (CFG_NUM_KEYS * sizeof(prv_journal_entry_t)))
+
+BUILD_ASSERT(CFG_NUM_KEYS < CFG_TXN_JOURNAL_ID, "Too many config keys for the transaction journal ID");
+#endif
+
 /*****************************************************************************
  * Variables
  *****************************************************************************/
 
+#ifdef CONFIG_ZMOD_CONFIG_ZBUS_KEY_CHANNELS
+#define CFG_DEFINE(key, type, default_val, rst) [key] = &zmod_cfg_##key##_chan,
+static const struct zbus_channel *const prv_key_chans[] = {
+#include CONFIG_ZMOD_CONFIG_APP_DEF_PATH
+};
+#undef CFG_DEFINE
+#endif
+
+#ifdef CONFIG_ZMOD_CONFIG_CACHE
+#define CFG_DEFINE(key, type, default_val, rst) [key] = offsetof(prv_cache_values_t, key),
+static const size_t prv_cache_offsets[] = {
+#include CONFIG_ZMOD_CONFIG_APP_DEF_PATH
+};
+#undef CFG_DEFINE
+#endif
+
 static struct {
     struct nvs_fs fs; // NVS filesystem instance for config storage
+#ifdef CONFIG_ZMOD_CONFIG_CACHE
+    prv_cache_values_t cache;      // RAM copy of every value, read by get
+    bool cached[CFG_NUM_KEYS];     // Cache slot holds the current value
+    struct k_spinlock cache_lock;  // Keeps cache copies whole
+#endif
+#ifdef CFG_COMMIT_LOCK
+    struct k_mutex commit_lock;          // Serializes sets, flushes, resets and journal writes
+#endif
+#ifdef CONFIG_ZMOD_CONFIG_WRITE_BACK
+    ATOMIC_DEFINE(dirty, CFG_NUM_KEYS);  // Cached value not yet written to NVS
+    bool pending;                        // A commit is scheduled; under cache_lock
+    int64_t pending_since;               // Uptime of the oldest uncommitted set
+    struct k_work_delayable commit_work; // Writes dirty keys after the quiet period
+    prv_value_buf_t flush_buf;           // Value being written; under commit_lock
+#endif
+#ifdef CONFIG_ZMOD_CONFIG_TXN
+    struct k_mutex txn_lock;             // Held from begin to commit or abort
+    k_tid_t txn_owner;                   // Thread with the open transaction
+    prv_cache_values_t txn_values;       // Staged values
+    ATOMIC_DEFINE(txn_staged, CFG_NUM_KEYS);
+    ATOMIC_DEFINE(journaled, CFG_NUM_KEYS); // Current value lives in the journal; under commit_lock
+    uint8_t txn_journal[CFG_TXN_JOURNAL_SIZE]; // Under commit_lock
+#endif
 } prv_inst;
 
 /*****************************************************************************
  * Prototypes
  *****************************************************************************/
 
+#ifdef CONFIG_ZMOD_CONFIG_CACHE
+static void prv_cache_load(void);
+static bool prv_cache_get(config_key_t key, void *dst, size_t size);
+static void prv_cache_put(config_key_t key, const void *src, size_t size);
+#endif
+static bool prv_nvs_write(config_key_t key, const config_entry_t *entry, const void *src, size_t size);
+#ifdef CONFIG_ZMOD_CONFIG_ZBUS_PUBLISH
+static void prv_publish_change(config_key_t key, const void *value);
+#endif
+#ifdef CONFIG_ZMOD_CONFIG_WRITE_BACK
+static void prv_dirty_mark(config_key_t key);
+static bool prv_flush(void);
+static void prv_commit_work_handler(struct k_work *work);
+#endif
+#ifdef CONFIG_ZMOD_CONFIG_TXN
+static void prv_txn_load(void);
+static size_t prv_txn_journal_build(bool staged);
+static bool prv_txn_journal_save(bool staged);
+static void prv_txn_end(void);
+#endif
+
 /*****************************************************************************
  * Public Functions
  *****************************************************************************/
 
 void zmod_config_mgr_init(void) {
+#ifdef CFG_COMMIT_LOCK
+    k_mutex_init(&prv_inst.commit_lock);
+#endif
+#ifdef CONFIG_ZMOD_CONFIG_WRITE_BACK
+    k_work_init_delayable(&prv_inst.commit_work, prv_commit_work_handler);
+#endif
+#ifdef CONFIG_ZMOD_CONFIG_TXN
+    k_mutex_init(&prv_inst.txn_lock);
+#endif
+
     const struct flash_area *fa;
     int rc = flash_area_open(FLASH_AREA_ID(CFG_OPT_FLASH_AREA), &fa);
     if (rc < 0) {
@@ -71,6 +218,18 @@ void zmod_config_mgr_init(void) {
         LOG_ERR("NVS failed to mount: %d", rc);
     }
 
+#ifdef CONFIG_ZMOD_CONFIG_CACHE
+    if (rc == 0) {
+        prv_cache_load();
+    }
+#endif
+
+#ifdef CONFIG_ZMOD_CONFIG_TXN
+    if (rc == 0) {
+        prv_txn_load();
+    }
+#endif
+
     LOG_INF("Zmod config module v%s initialized", ZMOD_CONFIG_VERSION_STRING);
 }
 
@@ -91,6 +250,12 @@ bool zmod_config_mgr_get_value(config_key_t key, void *dst, size_t size) {
              entry->value_size_bytes,
              size);
 
+#ifdef CONFIG_ZMOD_CONFIG_CACHE
+    if (prv_cache_get(key, dst, MIN(size, entry->value_size_bytes))) {
+        return true;
+    }
+#endif
+
     ssize_t ret = nvs_read(&prv_inst.fs, key, dst, size);
 
     // Configuration not in flash, so use default
@@ -108,6 +273,20 @@ bool zmod_config_mgr_get_value(config_key_t key, void *dst, size_t size) {
     return true;
 }
 
+#ifdef CONFIG_ZMOD_CONFIG_CACHE
+bool zmod_config_mgr_get_cached(config_key_t key, void *dst, size_t size) {
+    if ((size_t)key >= CFG_NUM_KEYS) {
+        return false;
+    }
+
+    if (prv_cache_get(key, dst, size)) {
+        return true;
+    }
+
+    return zmod_config_mgr_get_value(key, dst, size);
+}
+#endif
+
 bool zmod_config_mgr_set_value(config_key_t key, const void *src, size_t size) {
     if (src == NULL) {
         return false;
@@ -125,27 +304,218 @@ bool zmod_config_mgr_set_value(config_key_t key, const void *src, size_t size) {
              entry->value_size_bytes,
              size);
 
-    ssize_t ret = nvs_write(&prv_inst.fs, key, src, size);
+#ifdef CONFIG_ZMOD_CONFIG_WRITE_BACK
+    prv_cache_put(key, src, MIN(size, entry->value_size_bytes));
+    prv_dirty_mark(key);
+#else
+#ifdef CFG_COMMIT_LOCK
+    // Held across the write and the cache update so both end up with the same value
+    (void)k_mutex_lock(&prv_inst.commit_lock, K_FOREVER);
+#endif
 
-    if (ret < 0) {
-        LOG_ERR("Failed to write config value for key %s: %d", entry->human_readable_key, ret);
+    bool ok = prv_nvs_write(key, entry, src, size);
+
+#ifdef CONFIG_ZMOD_CONFIG_CACHE
+    if (ok) {
+        prv_cache_put(key, src, MIN(size, entry->value_size_bytes));
+    }
+#endif
+
+#ifdef CONFIG_ZMOD_CONFIG_TXN
+    // The key's own record is current again, so the journal must stop overriding it
+    if (ok && atomic_test_and_clear_bit(prv_inst.journaled, key) && !prv_txn_journal_save(false)) {
+        // The next journal write carries the new value instead
+        atomic_set_bit(prv_inst.journaled, key);
+        ok = false;
+    }
+#endif
+
+#ifdef CFG_COMMIT_LOCK
+    k_mutex_unlock(&prv_inst.commit_lock);
+#endif
+
+    if (!ok) {
+        return false;
+    }
+#endif
+
+#ifdef CONFIG_ZMOD_CONFIG_ZBUS_PUBLISH
+    prv_publish_change(key, src);
+#endif
+
+    return true;
+}
+
+bool zmod_config_mgr_commit(void) {
+#ifdef CONFIG_ZMOD_CONFIG_WRITE_BACK
+    (void)k_work_cancel_delayable(&prv_inst.commit_work);
+
+    if (!prv_flush()) {
+        // Keys left dirty are retried like a failed background commit
+        (void)k_work_reschedule(&prv_inst.commit_work, K_MSEC(CFG_WRITE_BACK_DELAY_MS));
+        return false;
+    }
+
+    return true;
+#else
+    return true;
+#endif
+}
+
+#ifdef CONFIG_ZMOD_CONFIG_TXN
+bool zmod_config_mgr_txn_begin(void) {
+    if (prv_inst.txn_owner == k_current_get()) {
+        LOG_ERR("Config transaction already open");
+        return false;
+    }
+
+    (void)k_mutex_lock(&prv_inst.txn_lock, K_FOREVER);
+    prv_inst.txn_owner = k_current_get();
+    memset(prv_inst.txn_staged, 0, sizeof(prv_inst.txn_staged));
+
+    return true;
+}
+
+bool zmod_config_mgr_txn_set(config_key_t key, const void *src, size_t size) {
+    if ((src == NULL) || (prv_inst.txn_owner != k_current_get())) {
+        return false;
+    }
+
+    config_entry_t *entry = zmod_configs_get_entry(key);
+
+    if (entry == NULL) {
         return false;
     }
 
+    __ASSERT(size == entry->value_size_bytes,
+             "Size of src buffer for %s incorrect.  Expected %u but got %u.",
+             entry->human_readable_key,
+             entry->value_size_bytes,
+             size);
+
+    memcpy((uint8_t *)&prv_inst.txn_values + prv_cache_offsets[key], src, MIN(size, entry->value_size_bytes));
+    atomic_set_bit(prv_inst.txn_staged, key);
+
     return true;
 }
 
+bool zmod_config_mgr_txn_commit(void) {
+    if (prv_inst.txn_owner != k_current_get()) {
+        return false;
+    }
+
+    bool staged = false;
+
+    for (size_t i = 0; i < CFG_NUM_KEYS; i++) {
+        staged = staged || atomic_test_bit(prv_inst.txn_staged, i);
+    }
+
+    if (!staged) {
+        prv_txn_end();
+        return true;
+    }
+
+    (void)k_mutex_lock(&prv_inst.commit_lock, K_FOREVER);
+
+    // The journal write is the only flash write and the commit point
+    bool ok = prv_txn_journal_save(true);
+
+    if (ok) {
+        for (size_t i = 0; i < CFG_NUM_KEYS; i++) {
+            if (atomic_test_bit(prv_inst.txn_staged, i)) {
+                atomic_set_bit(prv_inst.journaled, i);
+#ifdef CONFIG_ZMOD_CONFIG_WRITE_BACK
+                // The journal holds the value now; cleared before the cache update so a racing set stays dirty
+                atomic_clear_bit(prv_inst.dirty, i);
+#endif
+            }
+        }
+
+        // Readers see the whole group at once
+        k_spinlock_key_t lock = k_spin_lock(&prv_inst.cache_lock);
+        for (size_t i = 0; i < CFG_NUM_KEYS; i++) {
+            if (atomic_test_bit(prv_inst.txn_staged, i)) {
+                memcpy((uint8_t *)&prv_inst.cache + prv_cache_offsets[i],
+                       (uint8_t *)&prv_inst.txn_values + prv_cache_offsets[i],
+                       zmod_configs_get_entry(i)->value_size_bytes);
+                prv_inst.cached[i] = true;
+            }
+        }
+        k_spin_unlock(&prv_inst.cache_lock, lock);
+    }
+
+    k_mutex_unlock(&prv_inst.commit_lock);
+
+#ifdef CONFIG_ZMOD_CONFIG_ZBUS_PUBLISH
+    for (size_t i = 0; ok && (i < CFG_NUM_KEYS); i++) {
+        if (atomic_test_bit(prv_inst.txn_staged, i)) {
+            prv_publish_change(i, (uint8_t *)&prv_inst.txn_values + prv_cache_offsets[i]);
+        }
+    }
+#endif
+
+    prv_txn_end();
+
+    return ok;
+}
+
+void zmod_config_mgr_txn_abort(void) {
+    if (prv_inst.txn_owner != k_current_get()) {
+        return;
+    }
+
+    prv_txn_end();
+}
+#endif
+
 void zmod_config_mgr_reset_nvs(void) {
+#ifdef CFG_COMMIT_LOCK
+    (void)k_mutex_lock(&prv_inst.commit_lock, K_FOREVER);
+#endif
+
     for (size_t i = 0; i < CFG_NUM_KEYS; i++) {
+#ifdef CONFIG_ZMOD_CONFIG_WRITE_BACK
+        atomic_clear_bit(prv_inst.dirty, i);
+#endif
         int ret = nvs_delete(&prv_inst.fs, i);
 
         if (ret != 0) {
             LOG_ERR("Failed to reset %s to default: %d", zmod_config_key_as_str(i), ret);
+            continue;
         }
+
+#ifdef CONFIG_ZMOD_CONFIG_TXN
+        atomic_clear_bit(prv_inst.journaled, i);
+#endif
+#if defined(CONFIG_ZMOD_CONFIG_CACHE) || defined(CONFIG_ZMOD_CONFIG_ZBUS_PUBLISH)
+        config_entry_t *entry = zmod_configs_get_entry(i);
+#endif
+#ifdef CONFIG_ZMOD_CONFIG_CACHE
+        prv_cache_put(i, entry->default_value, entry->value_size_bytes);
+#endif
+#ifdef CONFIG_ZMOD_CONFIG_ZBUS_PUBLISH
+        prv_publish_change(i, entry->default_value);
+#endif
     }
+
+#ifdef CONFIG_ZMOD_CONFIG_TXN
+    // Last, so a reset part way through cannot leave part of a group behind
+    (void)prv_txn_journal_save(false);
+#endif
+
+#ifdef CFG_COMMIT_LOCK
+    k_mutex_unlock(&prv_inst.commit_lock);
+#endif
 }
 
 void zmod_config_mgr_reset_configs(void) {
+#ifdef CFG_COMMIT_LOCK
+    (void)k_mutex_lock(&prv_inst.commit_lock, K_FOREVER);
+#endif
+#ifdef CONFIG_ZMOD_CONFIG_TXN
+    bool journal_changed = false;
+#endif
+
     for (size_t i = 0; i < CFG_NUM_KEYS; i++) {
         config_entry_t *entry = zmod_configs_get_entry(i);
         if (entry == NULL) {
@@ -154,21 +524,394 @@ void zmod_config_mgr_reset_configs(void) {
 
         // Only reset entries that are marked as resettable
         if (entry->resettable) {
+#ifdef CONFIG_ZMOD_CONFIG_WRITE_BACK
+            atomic_clear_bit(prv_inst.dirty, i);
+#endif
             int ret = nvs_delete(&prv_inst.fs, i);
 
             if (ret != 0) {
                 LOG_ERR("Failed to reset %s to default: %d", zmod_config_key_as_str(i), ret);
             } else {
+#ifdef CONFIG_ZMOD_CONFIG_TXN
+                journal_changed |= atomic_test_and_clear_bit(prv_inst.journaled, i);
+#endif
+#ifdef CONFIG_ZMOD_CONFIG_CACHE
+                prv_cache_put(i, entry->default_value, entry->value_size_bytes);
+#endif
+#ifdef CONFIG_ZMOD_CONFIG_ZBUS_PUBLISH
+                prv_publish_change(i, entry->default_value);
+#endif
                 LOG_DBG("Reset %s to default", zmod_config_key_as_str(i));
             }
         }
     }
+
+#ifdef CONFIG_ZMOD_CONFIG_TXN
+    // Drop the reset keys from the journal so it cannot restore them at init
+    if (journal_changed) {
+        (void)prv_txn_journal_save(false);
+    }
+#endif
+
+#ifdef CFG_COMMIT_LOCK
+    k_mutex_unlock(&prv_inst.commit_lock);
+#endif
 }
 
 /*****************************************************************************
  * Private Functions
  *****************************************************************************/
 
+#ifdef CONFIG_ZMOD_CONFIG_CACHE
+/**
+ * @brief Read every key from NVS into the cache, defaults for keys not in flash
+ *
+ * A key that fails to read stays uncached and is read from NVS on every get.
+ */
+static void prv_cache_load(void) {
+    uint8_t *base = (uint8_t *)&prv_inst.cache;
+
+    for (size_t i = 0; i < CFG_NUM_KEYS; i++) {
+        config_entry_t *entry = zmod_configs_get_entry(i);
+        uint8_t *slot = base + prv_cache_offsets[i];
+
+        ssize_t ret = nvs_read(&prv_inst.fs, i, slot, entry->value_size_bytes);
+
+        if (ret == -ENOENT) {
+            memcpy(slot, entry->default_value, entry->value_size_bytes);
+        } else if (ret != (ssize_t)entry->value_size_bytes) {
+            LOG_WRN("Not caching %s: read returned %d", entry->human_readable_key, ret);
+            continue;
+        }
+
+        prv_inst.cached[i] = true;
+    }
+}
+
+/**
+ * @brief Copy the cached value of a key
+ *
+ * @return Returns false if the key is not cached
+ */
+static bool prv_cache_get(config_key_t key, void *dst, size_t size) {
+    k_spinlock_key_t lock = k_spin_lock(&prv_inst.cache_lock);
+    bool hit = prv_inst.cached[key];
+
+    if (hit) {
+        memcpy(dst, (uint8_t *)&prv_inst.cache + prv_cache_offsets[key], size);
+    }
+
+    k_spin_unlock(&prv_inst.cache_lock, lock);
+
+    return hit;
+}
+
+/**
+ * @brief Store a value written to NVS in the cache
+ */
+static void prv_cache_put(config_key_t key, const void *src, size_t size) {
+    k_spinlock_key_t lock = k_spin_lock(&prv_inst.cache_lock);
+
+    memcpy((uint8_t *)&prv_inst.cache + prv_cache_offsets[key], src, size);
+    prv_inst.cached[key] = true;
+
+    k_spin_unlock(&prv_inst.cache_lock, lock);
+}
+#endif
+
+/**
+ * @brief Write a value to NVS, logging failures
+ */
+static bool prv_nvs_write(config_key_t key, const config_entry_t *entry, const void *src, size_t size) {
+    ssize_t ret = nvs_write(&prv_inst.fs, key, src, size);
+
+    if (ret < 0) {
+        LOG_ERR("Failed to write config value for key %s: %d", entry->human_readable_key, ret);
+        return false;
+    }
+
+    return true;
+}
+
+#ifdef CONFIG_ZMOD_CONFIG_ZBUS_PUBLISH
+/**
+ * @brief Announce a new value of a key on the change channel and its key channel
+ */
+static void prv_publish_change(config_key_t key, const void *value) {
+    struct zmod_config_changed_event evt = {
+        .key = key,
+        .size = zmod_configs_get_entry(key)->value_size_bytes,
+    };
+
+    int ret = zbus_chan_pub(&zmod_config_changed_chan, &evt, K_NO_WAIT);
+    if (ret != 0) {
+        LOG_WRN("Failed to publish change of %s: %d", zmod_config_key_as_str(key), ret);
+    }
+
+#ifdef CONFIG_ZMOD_CONFIG_ZBUS_KEY_CHANNELS
+    ret = zbus_chan_pub(prv_key_chans[key], value, K_NO_WAIT);
+    if (ret != 0) {
+        LOG_WRN("Failed to publish value of %s: %d", zmod_config_key_as_str(key), ret);
+    }
+#else
+    ARG_UNUSED(value);
+#endif
+}
+#endif
+
+#ifdef CONFIG_ZMOD_CONFIG_WRITE_BACK
+/**
+ * @brief Mark a key dirty and push the commit out by the quiet period
+ *
+ * The commit is never pushed past CONFIG_ZMOD_CONFIG_WRITE_BACK_MAX_DELAY_MS
+ * after the oldest uncommitted set, so a value that keeps changing is still
+ * written.
+ */
+static void prv_dirty_mark(config_key_t key) {
+    int64_t now = k_uptime_get();
+
+    atomic_set_bit(prv_inst.dirty, key);
+
+    k_spinlock_key_t lock = k_spin_lock(&prv_inst.cache_lock);
+    if (!prv_inst.pending) {
+        prv_inst.pending = true;
+        prv_inst.pending_since = now;
+    }
+    int64_t left = prv_inst.pending_since + CFG_WRITE_BACK_MAX_DELAY_MS - now;
+    k_spin_unlock(&prv_inst.cache_lock, lock);
+
+    (void)k_work_reschedule(&prv_inst.commit_work, K_MSEC(CLAMP(left, 0, CFG_WRITE_BACK_DELAY_MS)));
+}
+
+/**
+ * @brief Write every dirty key to NVS in one pass
+ *
+ * A key set again while it is being written stays dirty and goes out with
+ * the next commit. Keys that fail to write stay dirty.
+ *
+ * @return Returns true if every dirty key was written
+ */
+static bool prv_flush(void) {
+    bool ok = true;
+    uint32_t written = 0;
+#ifdef CONFIG_ZMOD_CONFIG_TXN
+    ATOMIC_DEFINE(dropped, CFG_NUM_KEYS) = {0};
+    bool journal_changed = false;
+#endif
+
+    (void)k_mutex_lock(&prv_inst.commit_lock, K_FOREVER);
+
+    k_spinlock_key_t lock = k_spin_lock(&prv_inst.cache_lock);
+    prv_inst.pending = false;
+    k_spin_unlock(&prv_inst.cache_lock, lock);
+
+    for (size_t i = 0; i < CFG_NUM_KEYS; i++) {
+        if (!atomic_test_and_clear_bit(prv_inst.dirty, i)) {
+            continue;
+        }
+
+        config_entry_t *entry = zmod_configs_get_entry(i);
+
+        (void)prv_cache_get(i, &prv_inst.flush_buf, entry->value_size_bytes);
+
+        if (!prv_nvs_write(i, entry, &prv_inst.flush_buf, entry->value_size_bytes)) {
+            atomic_set_bit(prv_inst.dirty, i);
+            ok = false;
+            continue;
+        }
+
+#ifdef CONFIG_ZMOD_CONFIG_TXN
+        if (atomic_test_and_clear_bit(prv_inst.journaled, i)) {
+            atomic_set_bit(dropped, i);
+            journal_changed = true;
+        }
+#endif
+        written++;
+    }
+
+#ifdef CONFIG_ZMOD_CONFIG_TXN
+    // One journal rewrite drops every key whose own record was just written
+    if (journal_changed && !prv_txn_journal_save(false)) {
+        // Keep them journaled and dirty so the retry drops them again
+        for (size_t i = 0; i < CFG_NUM_KEYS; i++) {
+            if (atomic_test_bit(dropped, i)) {
+                atomic_set_bit(prv_inst.journaled, i);
+                atomic_set_bit(prv_inst.dirty, i);
+            }
+        }
+        ok = false;
+    }
+#endif
+
+    k_mutex_unlock(&prv_inst.commit_lock);
+
+    if (written > 0U) {
+        LOG_DBG("Committed %u config values", written);
+    }
+
+    return ok;
+}
+
+/**
+ * @brief Background commit; retries after the quiet period if a write failed
+ */
+static void prv_commit_work_handler(struct k_work *work) {
+    ARG_UNUSED(work);
+
+    if (!prv_flush()) {
+        (void)k_work_reschedule(&prv_inst.commit_work, K_MSEC(CFG_WRITE_BACK_DELAY_MS));
+    }
+}
+
+#ifdef CONFIG_ZMOD_CONFIG_WRITE_BACK_IWDOG_FLUSH
+/**
+ * @brief Commit pending values when a watchdog reset is imminent
+ *
+ * Listeners run in the publisher's context, so the write is handed to the
+ * commit work item instead of being done here.
+ */
+static void prv_iwdog_listener(const struct zbus_channel *chan) {
+    ARG_UNUSED(chan);
+
+    (void)k_work_reschedule(&prv_inst.commit_work, K_NO_WAIT);
+}
+
+ZBUS_LISTENER_DEFINE(zmod_config_iwdog_listener, prv_iwdog_listener);
+ZBUS_CHAN_ADD_OBS(zmod_iwdog_warning_chan, zmod_config_iwdog_listener, 3);
+#endif
+#endif
+
+#ifdef CONFIG_ZMOD_CONFIG_TXN
+/**
+ * @brief Apply the journal over the values read from the key records
+ *
+ * The journal is checked in full before any value is used; a malformed
+ * journal is discarded. Nothing is written.
+ */
+static void prv_txn_load(void) {
+    uint8_t *journal = prv_inst.txn_journal;
+    ssize_t len = nvs_read(&prv_inst.fs, CFG_TXN_JOURNAL_ID, journal, sizeof(prv_inst.txn_journal));
+
+    if (len == -ENOENT) {
+        return;
+    }
+
+    uint16_t count = 0;
+    size_t pos = sizeof(count);
+    bool valid = (len >= (ssize_t)sizeof(count)) && (len <= (ssize_t)sizeof(prv_inst.txn_journal));
+
+    if (valid) {
+        memcpy(&count, journal, sizeof(count));
+    }
+
+    for (uint16_t n = 0; valid && (n < count); n++) {
+        prv_journal_entry_t hdr;
+
+        valid = (pos + sizeof(hdr)) <= (size_t)len;
+        if (valid) {
+            memcpy(&hdr, journal + pos, sizeof(hdr));
+            pos += sizeof(hdr);
+            valid = (hdr.key < CFG_NUM_KEYS) && (hdr.len == zmod_configs_get_entry(hdr.key)->value_size_bytes) &&
+                    ((pos + hdr.len) <= (size_t)len);
+            pos += hdr.len;
+        }
+    }
+
+    if (!valid) {
+        LOG_ERR("Discarding malformed config transaction journal");
+        (void)nvs_delete(&prv_inst.fs, CFG_TXN_JOURNAL_ID);
+        return;
+    }
+
+    pos = sizeof(count);
+    for (uint16_t n = 0; n < count; n++) {
+        prv_journal_entry_t hdr;
+
+        memcpy(&hdr, journal + pos, sizeof(hdr));
+        pos += sizeof(hdr);
+        prv_cache_put(hdr.key, journal + pos, hdr.len);
+        atomic_set_bit(prv_inst.journaled, hdr.key);
+        pos += hdr.len;
+    }
+
+    LOG_DBG("Loaded %u config values from the transaction journal", count);
+}
+
+/**
+ * @brief Serialize the journaled keys, and the staged ones if @p staged, into the journal buffer
+ *
+ * A staged value takes the place of the journaled one for the same key.
+ *
+ * @return Returns journal length in bytes, or 0 if there is nothing to journal
+ */
+static size_t prv_txn_journal_build(bool staged) {
+    uint8_t *journal = prv_inst.txn_journal;
+    uint16_t count = 0;
+    size_t pos = sizeof(count);
+
+    for (size_t i = 0; i < CFG_NUM_KEYS; i++) {
+        bool from_txn = staged && atomic_test_bit(prv_inst.txn_staged, i);
+
+        if (!from_txn && !atomic_test_bit(prv_inst.journaled, i)) {
+            continue;
+        }
+
+        prv_journal_entry_t hdr = {
+            .key = (uint16_t)i,
+            .len = (uint16_t)zmod_configs_get_entry(i)->value_size_bytes,
+        };
+
+        memcpy(journal + pos, &hdr, sizeof(hdr));
+        pos += sizeof(hdr);
+        if (from_txn) {
+            memcpy(journal + pos, (uint8_t *)&prv_inst.txn_values + prv_cache_offsets[i], hdr.len);
+        } else {
+            (void)prv_cache_get(i, journal + pos, hdr.len);
+        }
+        pos += hdr.len;
+        count++;
+    }
+
+    memcpy(journal, &count, sizeof(count));
+
+    return (count > 0U) ? pos : 0U;
+}
+
+/**
+ * @brief Rewrite the journal, or delete it once no key is journaled
+ *
+ * Called with commit_lock held.
+ *
+ * @return Returns true on success
+ */
+static bool prv_txn_journal_save(bool staged) {
+    size_t len = prv_txn_journal_build(staged);
+    ssize_t ret;
+
+    if (len == 0U) {
+        ret = nvs_delete(&prv_inst.fs, CFG_TXN_JOURNAL_ID);
+    } else {
+        ret = nvs_write(&prv_inst.fs, CFG_TXN_JOURNAL_ID, prv_inst.txn_journal, len);
+    }
+
+    if (ret < 0) {
+        LOG_ERR("Failed to write config transaction journal: %d", ret);
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Close the open transaction and let the next one begin
+ */
+static void prv_txn_end(void) {
+    memset(prv_inst.txn_staged, 0, sizeof(prv_inst.txn_staged));
+    prv_inst.txn_owner = NULL;
+    k_mutex_unlock(&prv_inst.txn_lock);
+}
+#endif
+
 /*****************************************************************************
  * Shell Commands
  *****************************************************************************/
@@ -253,6 +996,24 @@ static int cmd_config_reset_configs(const struct shell *sh, size_t argc, char **
     return 0;
 }
 
+#ifdef CONFIG_ZMOD_CONFIG_WRITE_BACK
+/**
+ * @brief Shell command to write pending configuration values to NVS
+ */
+static int cmd_config_commit(const struct shell *sh, size_t argc, char **argv) {
+    ARG_UNUSED(argc);
+    ARG_UNUSED(argv);
+
+    if (!zmod_config_mgr_commit()) {
+        shell_error(sh, "Commit failed; pending values kept");
+        return -EIO;
+    }
+
+    shell_print(sh, "Pending config values committed");
+    return 0;
+}
+#endif
+
 SHELL_STATIC_SUBCMD_SET_CREATE(config_cmds,
                                SHELL_CMD_ARG(list,
                                              NULL,
@@ -280,6 +1041,15 @@ SHELL_STATIC_SUBCMD_SET_CREATE(config_cmds,
                                              cmd_config_reset_configs,
                                              1,
                                              0),
+                               SHELL_COND_CMD_ARG(CONFIG_ZMOD_CONFIG_WRITE_BACK,
+                                                  commit,
+                                                  NULL,
+                                                  "Write pending configuration values to NVS now.\n"
+                                                  "usage:\n"
+                                                  "$ zmod_config commit\n",
+                                                  cmd_config_commit,
+                                                  1,
+                                                  0),
                                SHELL_SUBCMD_SET_END);
 
 SHELL_CMD_REGISTER(zmod_config, &config_cmds, "Configuration management commands", NULL);
@@ -6,7 +6,7 @@
 
 /**
  * @file flash_log_backend.h
- * @brief Interface for forcing inclusion of the flash log backend.
+ * @brief Interface to the flash log backend.
  */
 
 #ifndef ZMOD_FLASH_LOG_BACKEND_H
@@ -16,6 +16,18 @@
 extern "C" {
 #endif
 
+struct log_backend;
+
+/**
+ * @brief Get the Zephyr log backend instance that feeds log storage.
+ *
+ * Pass it to log_filter_set()/log_filter_get() to filter what is stored
+ * independently of the other backends.
+ *
+ * @return Flash log backend.
+ */
+const struct log_backend *zmod_flash_log_backend_get(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -16,22 +16,115 @@
 extern "C" {
 #endif
 
+#include <stdbool.h>
 #include <stdint.h>
 #include <stddef.h>
 #include <zephyr/fs/fcb.h>
 
+#ifdef CONFIG_ZMOD_LOG_STORAGE_WEAR_ZBUS_PUBLISH
+#include <zephyr/zbus/zbus.h>
+#endif
+
 /**
  * @brief Metadata persisted alongside the flash circular buffer.
  *
- * The structure is written to flash to track the head and tail positions
- * of the log storage, enabling recovery after resets.
+ * With @kconfig{CONFIG_ZMOD_LOG_STORAGE_FAST_MOUNT} a record is appended to a
+ * journal sector whenever the head (oldest) or tail (active) FCB sector
+ * changes, so boot can resume from it instead of scanning every sector.
  */
 typedef struct zmod_log_storage_metadata_t {
     uint32_t magic;          /**< Magic word indicating a valid metadata block. */
-    struct fcb_entry head;   /**< Cached head entry for the ring buffer. */
-    struct fcb_entry tail;   /**< Cached tail entry for the ring buffer. */
+    uint32_t seq;            /**< Sequence number, incremented per record. */
+    uint16_t head_sector;    /**< Index of the oldest FCB sector. */
+    uint16_t tail_sector;    /**< Index of the FCB sector being appended to. */
+    uint8_t head_hdr[8];     /**< On-flash FCB header of the head sector. */
+    uint8_t tail_hdr[8];     /**< On-flash FCB header of the tail sector. */
+    uint32_t crc;            /**< CRC32 of all preceding fields. */
 } zmod_log_storage_metadata_t;
 
+/**
+ * @brief Log data lost before reaching flash.
+ */
+typedef struct zmod_log_storage_drops_t {
+    uint32_t ring_full_records;   /**< Records refused because the staging ring was full. */
+    uint32_t ring_full_bytes;     /**< Bytes in those records. */
+    uint32_t write_failed_bytes;  /**< Staged bytes lost to flash write failures. */
+    uint32_t panic_full_bytes;    /**< Bytes that did not fit in the panic sector. */
+} zmod_log_storage_drops_t;
+
+/**
+ * @brief Storage activity counters since boot.
+ */
+typedef struct zmod_log_storage_stats_t {
+    uint64_t bytes_written;          /**< FCB entry bytes written, both tiers. */
+    uint32_t records_written;        /**< FCB entries written, both tiers. */
+    uint32_t rotations;              /**< Oldest sectors rotated out, both tiers. */
+    uint32_t erases;                 /**< Sector erases; see zmod_log_storage_get_erase_counts(). */
+    uint32_t mutex_timeouts;         /**< Calls that gave up waiting for the storage mutex (-EBUSY). */
+    uint32_t export_dropped_records; /**< Records dropped because an export snapshot held flash. */
+    uint64_t fetch_bytes;            /**< Bytes returned by the fetch and cursor calls. */
+    uint32_t append_max_us;          /**< Slowest main log append, mutex wait included. */
+    uint32_t append_avg_us;          /**< Average main log append time. */
+    zmod_log_storage_drops_t drops;  /**< Same as zmod_log_storage_get_drops(). */
+} zmod_log_storage_stats_t;
+
+#ifdef CONFIG_ZMOD_LOG_STORAGE_BACKEND_FILTER
+/**
+ * @brief Per-source storage levels, persisted as the CFG_LOG_STORAGE_FILTER config key.
+ *
+ * Sources are identified by the CRC32 of their name so the table survives
+ * firmware updates that renumber log sources.
+ */
+typedef struct zmod_log_storage_filter_t {
+    uint8_t configured;     /**< Zero until first set; storage then follows the runtime level. */
+    uint8_t default_level;  /**< Level stored for sources without an override. */
+    uint8_t count;          /**< Overrides in use. */
+    uint8_t level[CONFIG_ZMOD_LOG_STORAGE_BACKEND_FILTER_OVERRIDES];        /**< Override levels. */
+    uint32_t source_hash[CONFIG_ZMOD_LOG_STORAGE_BACKEND_FILTER_OVERRIDES]; /**< CRC32 of each source name. */
+} zmod_log_storage_filter_t;
+#endif
+
+#ifdef CONFIG_ZMOD_LOG_STORAGE_WEAR
+/**
+ * @brief Flash wear record, persisted as the CFG_LOG_STORAGE_WEAR config key.
+ *
+ * Saved every @kconfig{CONFIG_ZMOD_LOG_STORAGE_WEAR_SAVE_ERASES} erases, so a
+ * reset loses at most that many.
+ */
+typedef struct zmod_log_storage_wear_t {
+    uint32_t uptime_s;        /**< Powered time covered by the record. */
+    uint32_t window_start_s;  /**< uptime_s when the current budget window opened. */
+    uint32_t window_erases;   /**< Erases in the current budget window. */
+    uint16_t sector_count;    /**< Partition sectors; a record for another layout is discarded. */
+    uint16_t reserved;
+    uint32_t erases[CONFIG_ZMOD_LOG_STORAGE_WEAR_MAX_SECTORS]; /**< Lifetime erases of each partition sector. */
+} zmod_log_storage_wear_t;
+
+/**
+ * @brief Wear summary from zmod_log_storage_get_wear(), also published on zmod_log_storage_wear_chan.
+ */
+struct zmod_log_storage_wear_event {
+    uint32_t total_erases;   /**< Lifetime erases across the partition. */
+    uint32_t max_erases;     /**< Lifetime erases of the most worn sector. */
+    uint32_t uptime_s;       /**< Powered time the counts cover. */
+    uint32_t window_erases;  /**< Erases in the current one-day budget window. */
+    uint32_t lifetime_days;  /**< Days until the most worn sector reaches its rated endurance at the
+                                  average erase rate; UINT32_MAX before the first erase. */
+    uint32_t dropped;        /**< Messages dropped by the throttle since boot. */
+    uint8_t throttle_level;  /**< Least severe level stored while over budget, 0 when not throttled. */
+};
+
+#ifdef CONFIG_ZMOD_LOG_STORAGE_WEAR_ZBUS_PUBLISH
+/* Zbus channel for log storage wear updates */
+ZBUS_CHAN_DECLARE(zmod_log_storage_wear_chan);
+#endif
+#endif
+
+/**
+ * @brief Independent read cursor from zmod_log_storage_cursor_open().
+ */
+typedef struct zmod_log_storage_read_ctx zmod_log_storage_cursor_t;
+
 /**
  * @brief Initialize the flash-backed log storage subsystem.
  *
@@ -47,20 +140,182 @@ int zmod_log_storage_init(void);
 /**
  * @brief Append raw log data to persistent storage.
  *
+ * With @kconfig{CONFIG_ZMOD_LOG_STORAGE_STAGING} enabled the data is copied
+ * into a lock-free RAM staging ring and written to flash later by the flusher
+ * thread, so this call never blocks and may be used from any context. It is
+ * equivalent to zmod_log_storage_reserve(), a copy and zmod_log_storage_commit().
+ *
  * @param buf Pointer to the log record buffer.
  * @param buf_size Number of bytes to write; zero is treated as a no-op.
  *
  * @retval 0 Success.
  * @retval -EINVAL When @p buf is NULL.
+ * @retval -ENOMEM Staging ring is full or the record is larger than half the
+ *                 ring; the data was dropped.
+ * @retval -EAGAIN Without staging: flash is full and the oldest sector is
+ *                 pinned by an export or a span; the data was dropped.
  * @retval -EBUSY Unable to obtain mutex within timeout.
  * @retval Negative errno value from flash/FCB APIs.
  */
 int zmod_log_storage_add_data(const void *buf, size_t buf_size);
 
+/**
+ * @brief Reserve space for one log record in the staging ring.
+ *
+ * Lock-free; several producers may hold reservations at once. Fill the
+ * returned buffer and pass it to zmod_log_storage_commit(). Records reach
+ * flash in reservation order, so an uncommitted record holds back the ones
+ * reserved after it: commit promptly.
+ *
+ * @param len Record length in bytes.
+ *
+ * @return Buffer of @p len bytes, or NULL when the ring is full (counted as a
+ *         drop), @p len is zero or larger than half the ring, storage is not
+ *         initialized, zmod_log_storage_panic() has switched to the panic
+ *         sector (@kconfig{CONFIG_ZMOD_LOG_STORAGE_PANIC_SECTOR}), or
+ *         @kconfig{CONFIG_ZMOD_LOG_STORAGE_STAGING} is disabled.
+ */
+void *zmod_log_storage_reserve(size_t len);
+
+/**
+ * @brief Hand a record filled after zmod_log_storage_reserve() to the flusher.
+ *
+ * @param buf Buffer returned by zmod_log_storage_reserve(); NULL is ignored.
+ */
+void zmod_log_storage_commit(void *buf);
+
+/**
+ * @brief Append a high-severity record to the priority tier.
+ *
+ * The record is staged like zmod_log_storage_add_data() and the flusher writes
+ * it to the priority tier, a small FCB on its own sectors that rotates
+ * independently of the main log, so rare errors outlive verbose output. It
+ * does not add the record to the main log; the flash backend stores qualifying
+ * lines in both. Lock-free and safe from any context. After
+ * zmod_log_storage_panic() this is a no-op.
+ *
+ * @param buf Pointer to the log record buffer.
+ * @param buf_size Number of bytes to write; zero is treated as a no-op.
+ *
+ * @retval 0 Success.
+ * @retval -EINVAL When @p buf is NULL.
+ * @retval -ENOMEM Staging ring is full or the record is larger than half the
+ *                 ring; the data was dropped.
+ * @retval -ENOTSUP @kconfig{CONFIG_ZMOD_LOG_STORAGE_PRIORITY_TIER} is disabled.
+ */
+int zmod_log_storage_add_priority(const void *buf, size_t buf_size);
+
+/**
+ * @brief Read the counters of log data dropped before reaching flash.
+ *
+ * Counters run from boot. All zero when staging is disabled.
+ *
+ * @param drops Populated with the current counters.
+ */
+void zmod_log_storage_get_drops(zmod_log_storage_drops_t *drops);
+
+/**
+ * @brief Read the storage activity counters.
+ *
+ * @param stats Populated with the counters since boot.
+ *
+ * @retval 0 Success.
+ * @retval -EINVAL When @p stats is NULL.
+ * @retval -ENODEV Storage is not initialized.
+ * @retval -EBUSY Unable to obtain mutex within timeout.
+ */
+int zmod_log_storage_get_stats(zmod_log_storage_stats_t *stats);
+
+/**
+ * @brief Read the number of erases of each sector of the logging partition since boot.
+ *
+ * Indexes follow the partition's sectors, reserved sectors included.
+ *
+ * @param counts Array to fill.
+ * @param max_counts Capacity of @p counts.
+ *
+ * @return Number of entries written to @p counts.
+ */
+size_t zmod_log_storage_get_erase_counts(uint32_t *counts, size_t max_counts);
+
+#ifdef CONFIG_ZMOD_LOG_STORAGE_WEAR
+/**
+ * @brief Read the lifetime wear of the logging partition.
+ *
+ * Counts from before the persisted record is loaded by
+ * zmod_log_storage_init_log_level() cover this boot only.
+ *
+ * @param wear Populated with the current summary.
+ *
+ * @retval 0 Success.
+ * @retval -EINVAL When @p wear is NULL.
+ * @retval -ENODEV Storage is not initialized.
+ * @retval -EBUSY Unable to obtain mutex within timeout.
+ */
+int zmod_log_storage_get_wear(struct zmod_log_storage_wear_event *wear);
+
+/**
+ * @brief Read the lifetime number of erases of each sector of the logging partition.
+ *
+ * Indexes match zmod_log_storage_get_erase_counts().
+ *
+ * @param counts Array to fill.
+ * @param max_counts Capacity of @p counts.
+ *
+ * @return Number of entries written to @p counts.
+ */
+size_t zmod_log_storage_get_wear_counts(uint32_t *counts, size_t max_counts);
+
+/**
+ * @brief Check whether the erase budget keeps a message of @p level out of flash.
+ *
+ * While the budget of @kconfig{CONFIG_ZMOD_LOG_STORAGE_WEAR_BUDGET_PER_DAY}
+ * erases is exceeded, only levels up to
+ * @kconfig{CONFIG_ZMOD_LOG_STORAGE_WEAR_THROTTLE_LEVEL} are stored. Messages
+ * without a level (printk) are dropped too. Each drop is counted. Called by
+ * the flash backend; lock-free.
+ *
+ * @param level Zephyr log level of the message.
+ *
+ * @return true if the message should not be stored.
+ */
+bool zmod_log_storage_wear_throttled(uint8_t level);
+#endif
+
+/**
+ * @brief Synchronously write all staged log data to flash.
+ *
+ * Runs in the caller's context. A no-op when staging is disabled.
+ *
+ * @retval 0 Success.
+ * @retval -ENODEV Storage has not been initialized.
+ * @retval -EBUSY Unable to obtain mutex within timeout.
+ * @retval Negative errno value from flash/FCB APIs.
+ */
+int zmod_log_storage_flush(void);
+
+/**
+ * @brief Switch storage to panic mode.
+ *
+ * Called by the flash log backend on LOG_PANIC(). With
+ * @kconfig{CONFIG_ZMOD_LOG_STORAGE_PANIC_SECTOR} staged data and every later
+ * zmod_log_storage_add_data() call go straight into a sector erased at boot.
+ * No mutex is taken and nothing is erased, so it works in fault context. The
+ * next zmod_log_storage_init() merges the sector into the FCB. Without the
+ * option this is zmod_log_storage_flush().
+ *
+ * @retval 0 Success.
+ * @retval -ENODEV Storage has not been initialized.
+ * @retval Negative errno value from zmod_log_storage_flush().
+ */
+int zmod_log_storage_panic(void);
+
 /**
  * @brief Fetch the next chunk of stored log bytes.
  *
  * Callers should continue invoking this function until it returns -ENOENT.
+ * Compressed containers are expanded, so the bytes match what the backend
+ * originally logged.
  *
  * @param dst Destination buffer to populate.
  * @param dest_size Destination buffer size in bytes.
@@ -74,6 +329,234 @@ int zmod_log_storage_add_data(const void *buf, size_t buf_size);
  */
 int zmod_log_storage_fetch_data(void *dst, size_t dest_size, size_t *out_size);
 
+/**
+ * @brief Fetch the next chunk of stored entries exactly as written to flash.
+ *
+ * Each entry is produced as a little-endian u16 length followed by the entry
+ * bytes, including container headers and compressed payloads. The output can
+ * be unpacked on the host with scripts/log_raw_decode.py. Shares the read
+ * cursor with zmod_log_storage_fetch_data(); call
+ * zmod_log_storage_reset_read() before switching between the two.
+ *
+ * @param dst Destination buffer to populate.
+ * @param dest_size Destination buffer size in bytes; must exceed 2.
+ * @param out_size Populated with the number of bytes written to @p dst.
+ *
+ * @retval 0 Success.
+ * @retval -ENOENT No additional data is available.
+ * @retval -EBUSY Unable to obtain mutex within timeout.
+ * @retval -EINVAL Invalid arguments.
+ * @retval -EIO Flash read failure.
+ */
+int zmod_log_storage_fetch_raw(void *dst, size_t dest_size, size_t *out_size);
+
+/**
+ * @brief Get the next span of log bytes from the default reader without copying them.
+ *
+ * Same as zmod_log_storage_cursor_fetch_span() on the cursor used by
+ * zmod_log_storage_fetch_data(). A span into the partition pins its sector
+ * until the next fetch, zmod_log_storage_reset_read() or seek.
+ *
+ * @param data Set to the start of the span.
+ * @param len Set to the span length in bytes.
+ *
+ * @retval 0 Success.
+ * @retval -ENOENT No additional data is available.
+ * @retval -EBUSY Unable to obtain mutex within timeout.
+ * @retval -EINVAL Invalid arguments.
+ * @retval -EIO Flash read failure.
+ */
+int zmod_log_storage_fetch_span(const void **data, size_t *len);
+
+/**
+ * @brief Restrict the read cursor to a window on the log clock.
+ *
+ * Timestamps are taken from container headers and count milliseconds of
+ * uptime continued across reboots, so they only ever increase. A per-sector
+ * index built on first use lets the cursor start at the first sector that
+ * overlaps the window; later fetches from zmod_log_storage_fetch_data() or
+ * zmod_log_storage_fetch_raw() return whole containers that overlap
+ * [@p since_ms, @p until_ms] and then -ENOENT. Clear the window with
+ * zmod_log_storage_reset_read().
+ *
+ * @param since_ms Start of the window (log clock, ms).
+ * @param until_ms End of the window (log clock, ms), inclusive.
+ *
+ * @retval 0 Cursor positioned.
+ * @retval -ENOENT No stored data overlaps the window.
+ * @retval -EINVAL @p since_ms is after @p until_ms.
+ * @retval -EBUSY Unable to obtain mutex within timeout.
+ * @retval -ENOTSUP @kconfig{CONFIG_ZMOD_LOG_STORAGE_TIME_INDEX} is disabled.
+ */
+int zmod_log_storage_seek_time(uint32_t since_ms, uint32_t until_ms);
+
+/**
+ * @brief Restart the read cursor at the newest stored logs.
+ *
+ * Positions the cursor so the following fetches return the last @p count
+ * records, or the last @p count log bytes when @p bytes is set, and then
+ * -ENOENT. A record is one zmod_log_storage_add_data() call, which the flash
+ * backend makes once per message. Staged records round out to whole
+ * containers, so a few more may be returned. The per-sector record and byte
+ * index is walked back from the newest sector in RAM, so only the entry
+ * headers of the sector the tail starts in are read. Raw fetches start at the
+ * entry holding the first byte. Clears any time window.
+ *
+ * @param count Number of records or bytes to keep.
+ * @param bytes Count log bytes instead of records.
+ *
+ * @retval 0 Cursor positioned; everything is returned if less is stored.
+ * @retval -EBUSY Unable to obtain mutex within timeout.
+ * @retval -EIO Flash read failure.
+ * @retval -ENOTSUP @kconfig{CONFIG_ZMOD_LOG_STORAGE_TAIL} is disabled.
+ */
+int zmod_log_storage_seek_tail(uint32_t count, bool bytes);
+
+/**
+ * @brief Report the log-clock span covered by stored containers.
+ *
+ * @param oldest_ms Populated with the first timestamp still in flash.
+ * @param newest_ms Populated with the last timestamp written to flash.
+ *
+ * @retval 0 Success.
+ * @retval -ENOENT No timestamped data is stored.
+ * @retval -EINVAL Invalid arguments.
+ * @retval -EBUSY Unable to obtain mutex within timeout.
+ * @retval -ENOTSUP @kconfig{CONFIG_ZMOD_LOG_STORAGE_TIME_INDEX} is disabled.
+ */
+int zmod_log_storage_time_range(uint32_t *oldest_ms, uint32_t *newest_ms);
+
+/**
+ * @brief Open an independent read cursor.
+ *
+ * Cursors come from a pool of @kconfig{CONFIG_ZMOD_LOG_STORAGE_READ_CURSORS}
+ * and do not affect each other or the cursor behind
+ * zmod_log_storage_fetch_data(). Opening flushes staged data, and the cursor
+ * reads the entries stored at that moment: later fetches end with -ENOENT at
+ * the last of them even while logging continues. Unlike an export started with
+ * zmod_log_storage_set_export_in_progress(), a cursor does not hold back
+ * sector rotation; if its position is rotated out it restarts from the oldest
+ * entry and the next fetch reports -ESTALE once.
+ *
+ * @return Cursor handle, or NULL if the pool is exhausted or storage is not
+ *         initialized.
+ */
+zmod_log_storage_cursor_t *zmod_log_storage_cursor_open(void);
+
+/**
+ * @brief Open a read cursor on the priority tier.
+ *
+ * Behaves like zmod_log_storage_cursor_open() and shares its pool; use the
+ * zmod_log_storage_cursor_*() calls to read and close it. Seeking by time
+ * skips entries outside the window while reading, the time index only covers
+ * the main log.
+ *
+ * @return Cursor handle, or NULL if the pool is exhausted, storage is not
+ *         initialized or @kconfig{CONFIG_ZMOD_LOG_STORAGE_PRIORITY_TIER} is
+ *         disabled.
+ */
+zmod_log_storage_cursor_t *zmod_log_storage_priority_cursor_open(void);
+
+/**
+ * @brief Restart a cursor inside a window on the log clock.
+ *
+ * Same window semantics as zmod_log_storage_seek_time(). Without
+ * @kconfig{CONFIG_ZMOD_LOG_STORAGE_TIME_INDEX} the cursor starts at the oldest
+ * entry and skips containers outside the window. Entries written without
+ * staging carry no timestamps and never match.
+ *
+ * @param cursor Open cursor.
+ * @param since_ms Start of the window (log clock, ms).
+ * @param until_ms End of the window (log clock, ms), inclusive.
+ *
+ * @retval 0 Cursor positioned.
+ * @retval -ENOENT No stored data overlaps the window.
+ * @retval -EINVAL Invalid cursor, or @p since_ms is after @p until_ms.
+ * @retval -EBUSY Unable to obtain mutex within timeout.
+ * @retval -ENOTSUP @kconfig{CONFIG_ZMOD_LOG_STORAGE_STAGING} is disabled.
+ */
+int zmod_log_storage_cursor_seek_time(zmod_log_storage_cursor_t *cursor, uint32_t since_ms, uint32_t until_ms);
+
+/**
+ * @brief Restart a cursor at the newest stored logs.
+ *
+ * Same semantics as zmod_log_storage_seek_tail().
+ *
+ * @param cursor Open cursor on the main log.
+ * @param count Number of records or bytes to keep.
+ * @param bytes Count log bytes instead of records.
+ *
+ * @retval 0 Cursor positioned.
+ * @retval -EINVAL Invalid cursor.
+ * @retval -EBUSY Unable to obtain mutex within timeout.
+ * @retval -EIO Flash read failure.
+ * @retval -ENOTSUP Priority tier cursor, or
+ *                  @kconfig{CONFIG_ZMOD_LOG_STORAGE_TAIL} is disabled.
+ */
+int zmod_log_storage_cursor_seek_tail(zmod_log_storage_cursor_t *cursor, uint32_t count, bool bytes);
+
+/**
+ * @brief Fetch the next chunk of log bytes through a cursor.
+ *
+ * Output matches zmod_log_storage_fetch_data(). The storage mutex is held for
+ * a single chunk, so concurrent readers and the flusher interleave.
+ *
+ * @param cursor Open cursor.
+ * @param dst Destination buffer to populate.
+ * @param dest_size Destination buffer size in bytes.
+ * @param out_size Populated with the number of bytes written to @p dst.
+ *
+ * @retval 0 Success.
+ * @retval -ENOENT No additional data is available.
+ * @retval -ESTALE Unread data was rotated out; the cursor now continues from
+ *                 the oldest entry.
+ * @retval -EBUSY Unable to obtain mutex within timeout.
+ * @retval -EINVAL Invalid arguments.
+ * @retval -EIO Flash read failure.
+ */
+int zmod_log_storage_cursor_fetch(zmod_log_storage_cursor_t *cursor, void *dst, size_t dest_size, size_t *out_size);
+
+/**
+ * @brief Get the next span of log bytes through a cursor without copying them.
+ *
+ * On memory-mapped SoC flash @p data points straight into the partition and
+ * covers the rest of the current entry. On external flash, and for compressed
+ * containers, up to @kconfig{CONFIG_ZMOD_LOG_STORAGE_SPAN_BOUNCE_SIZE} bytes
+ * are read into a buffer owned by the cursor. Either way the span stays valid
+ * until the next call on the same cursor or its close. Until then a span into
+ * the partition pins its sector: the ring does not rotate it out, and while
+ * the ring is full new data waits in the staging ring as during an export, so
+ * release the span promptly. Return values match
+ * zmod_log_storage_cursor_fetch().
+ *
+ * @param cursor Open cursor.
+ * @param data Set to the start of the span.
+ * @param len Set to the span length in bytes.
+ */
+int zmod_log_storage_cursor_fetch_span(zmod_log_storage_cursor_t *cursor, const void **data, size_t *len);
+
+/**
+ * @brief Fetch the next chunk of stored entries through a cursor, as written to flash.
+ *
+ * Output matches zmod_log_storage_fetch_raw(); return values match
+ * zmod_log_storage_cursor_fetch().
+ *
+ * @param cursor Open cursor.
+ * @param dst Destination buffer to populate; must hold more than two bytes.
+ * @param dest_size Destination buffer size in bytes.
+ * @param out_size Populated with the number of bytes written to @p dst.
+ */
+int zmod_log_storage_cursor_fetch_raw(zmod_log_storage_cursor_t *cursor, void *dst, size_t dest_size,
+                                      size_t *out_size);
+
+/**
+ * @brief Return a cursor to the pool.
+ *
+ * @param cursor Cursor from zmod_log_storage_cursor_open(); invalid handles
+ *               are ignored.
+ */
+void zmod_log_storage_cursor_close(zmod_log_storage_cursor_t *cursor);
+
 /**
  * @brief Reset the internal read cursor used during exports.
  */
@@ -82,7 +565,10 @@ void zmod_log_storage_reset_read(void);
 /**
  * @brief Clear all stored log entries from flash.
  *
+ * Erases the priority tier as well when it is enabled.
+ *
  * @retval 0 Success.
+ * @retval -EBUSY A cursor holds a span into the partition; nothing was erased.
  * @retval Negative errno value from FCB operations.
  */
 int zmod_log_storage_clear(void);
@@ -90,8 +576,14 @@ int zmod_log_storage_clear(void);
 /**
  * @brief Mark whether a log export is currently in progress.
  *
- * When @p in_progress is true the module pauses automatic writes to avoid
- * race conditions with active exports.
+ * Starting an export flushes staged data and freezes a snapshot: reads through
+ * zmod_log_storage_fetch_data() and zmod_log_storage_fetch_raw() end with
+ * -ENOENT at the last entry stored when the export began. Logging continues
+ * during the export. The sector the export is reading is protected from
+ * rotation; while the ring is full and waiting on it, new data queues in the
+ * staging ring and is counted as dropped once that fills.
+ *
+ * End the export promptly: an abandoned export keeps its sector pinned.
  *
  * @param in_progress Flag indicating export state.
  */
@@ -101,13 +593,21 @@ void zmod_log_storage_set_export_in_progress(bool in_progress);
  * @brief Initialize runtime log levels from persisted configuration.
  *
  * Reads log level from the Zmod Config module, applies minimum constraints,
- * and propagates the level to all registered modules.
+ * and propagates the level to all registered modules. With
+ * @kconfig{CONFIG_ZMOD_LOG_STORAGE_BACKEND_FILTER} the persisted storage
+ * filter is applied to the flash backend as well. With
+ * @kconfig{CONFIG_ZMOD_LOG_STORAGE_WEAR} the persisted wear record is loaded,
+ * so call this once the config store is ready.
  */
 void zmod_log_storage_init_log_level(void);
 
 /**
  * @brief Update the runtime log level for all modules and persist it.
  *
+ * With @kconfig{CONFIG_ZMOD_LOG_STORAGE_BACKEND_FILTER} this sets every
+ * backend except flash storage, which keeps its own filter once one has been
+ * set with zmod_log_storage_set_storage_level().
+ *
  * @param level Requested Zephyr log severity (1-4).
  *
  * @retval 0 Success.
@@ -116,6 +616,27 @@ void zmod_log_storage_init_log_level(void);
  */
 int zmod_log_storage_set_log_level(uint8_t level);
 
+/**
+ * @brief Set the level written to flash, independent of the console.
+ *
+ * Programs the flash backend's runtime filter and persists it in the
+ * CFG_LOG_STORAGE_FILTER config key. Levels below
+ * @kconfig{CONFIG_ZMOD_LOG_STORAGE_MIN_RUNTIME_LEVEL} are clamped. Until the
+ * first call, storage follows the runtime level.
+ *
+ * @param source Log module name, or NULL to set the level of every module
+ *               and drop all per-module overrides.
+ * @param level Requested Zephyr log severity (1-4).
+ *
+ * @retval 0 Success.
+ * @retval -EINVAL Requested level is invalid.
+ * @retval -ENOENT No log module named @p source.
+ * @retval -ENOMEM The override table is full.
+ * @retval -EIO Unable to persist the filter.
+ * @retval -ENOTSUP @kconfig{CONFIG_ZMOD_LOG_STORAGE_BACKEND_FILTER} is disabled.
+ */
+int zmod_log_storage_set_storage_level(const char *source, uint8_t level);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,113 @@
+#!/usr/bin/env python3
+# Copyright (c) 2025 Ovyl
+# SPDX-License-Identifier: Apache-2.0
+
+"""Decode dictionary-format logs exported from Zmod log storage.
+
+The device stores raw Zephyr dictionary log messages when
+CONFIG_ZMOD_LOG_STORAGE_FORMAT_DICTIONARY is enabled. This script takes either
+the hex text printed by `log_storage export` (shell prompts and other noise
+are ignored) or a binary dump from zmod_log_storage_fetch_data(), and rebuilds
+the text with Zephyr's dictionary parser and the build's log_dictionary.json.
+
+Each stored message is one record: a u16 little-endian length followed by the
+message. Records are decoded one at a time, so a message that does not parse
+is reported and skipped instead of derailing the rest of the export.
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+
+HEX_LINE_RE = re.compile(r"^[0-9a-fA-F]+$")
+
+RECORD_LEN = struct.Struct("<H")
+
+DEFAULT_DB_PATH = os.path.join("build", "zephyr", "log_dictionary.json")
+
+
+def load_zephyr_parser(zephyr_base):
+    """Make Zephyr's dictionary parser package importable and return it."""
+    parser_dir = os.path.join(zephyr_base, "scripts", "logging", "dictionary")
+    if not os.path.isdir(parser_dir):
+        sys.exit(f"Zephyr dictionary parser not found in {parser_dir}")
+
+    sys.path.insert(0, parser_dir)
+    import dictionary_parser  # pylint: disable=import-outside-toplevel
+    from dictionary_parser.log_database import LogDatabase  # pylint: disable=import-outside-toplevel
+
+    return dictionary_parser, LogDatabase
+
+
+def read_hex_export(path):
+    """Collect the hex lines from a captured shell export."""
+    data = bytearray()
+    with open(path, "r", encoding="utf-8", errors="ignore") as f:
+        for line in f:
+            line = line.strip()
+            if line and len(line) % 2 == 0 and HEX_LINE_RE.match(line):
+                data.extend(bytes.fromhex(line))
+    return bytes(data)
+
+
+def read_binary_export(path):
+    with open(path, "rb") as f:
+        return f.read()
+
+
+def split_records(logdata):
+    """Yield (offset, message) for each length-prefixed record."""
+    offset = 0
+    while offset + RECORD_LEN.size <= len(logdata):
+        (length,) = RECORD_LEN.unpack_from(logdata, offset)
+        start = offset + RECORD_LEN.size
+        if start + length > len(logdata):
+            print(f"Record at offset {offset} is truncated", file=sys.stderr)
+            return
+        yield offset, logdata[start:start + length]
+        offset = start + length
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode Zmod dictionary-format log exports")
+    parser.add_argument("input", help="Captured 'log_storage export' output or binary dump")
+    parser.add_argument("--db", default=DEFAULT_DB_PATH,
+                        help=f"Dictionary database (default: {DEFAULT_DB_PATH})")
+    parser.add_argument("--binary", action="store_true",
+                        help="Input is a raw binary dump instead of shell hex output")
+    parser.add_argument("--zephyr-base", default=os.environ.get("ZEPHYR_BASE"),
+                        help="Zephyr tree (default: $ZEPHYR_BASE)")
+    parser.add_argument("--debug", action="store_true", help="Print parser debug output")
+    args = parser.parse_args()
+
+    if not args.zephyr_base:
+        sys.exit("Set ZEPHYR_BASE or pass --zephyr-base")
+
+    dictionary_parser, LogDatabase = load_zephyr_parser(args.zephyr_base)
+
+    database = LogDatabase.read_json_database(args.db)
+    if database is None:
+        sys.exit(f"Unable to read dictionary database {args.db}")
+
+    logdata = read_binary_export(args.input) if args.binary else read_hex_export(args.input)
+    if not logdata:
+        sys.exit("No log data found in input")
+
+    log_parser = dictionary_parser.get_parser(database)
+    if log_parser is None:
+        sys.exit("Unsupported dictionary database version")
+
+    bad = 0
+    for offset, message in split_records(logdata):
+        if not log_parser.parse_log_data(message, debug=args.debug):
+            print(f"Record at offset {offset} did not match the database", file=sys.stderr)
+            bad += 1
+
+    if bad:
+        sys.exit(f"{bad} record(s) could not be decoded")
+
+
+if __name__ == "__main__":
+    main()
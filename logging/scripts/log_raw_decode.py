@@ -0,0 +1,126 @@
+#!/usr/bin/env python3
+# Copyright (c) 2025 Ovyl
+# SPDX-License-Identifier: Apache-2.0
+
+"""Unpack raw entry dumps from Zmod log storage.
+
+`log_storage export_raw` and zmod_log_storage_fetch_raw() emit every FCB
+entry as a little-endian u16 length followed by the entry bytes. Entries that
+start with a container header are unwrapped and, when LZ4-compressed, expanded
+(requires the `lz4` package). The recovered log stream is written to stdout or
+--out; dictionary-format logs can then be passed to log_dict_decode.py --binary.
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+HEX_LINE_RE = re.compile(r"^[0-9a-fA-F]+$")
+
+CONTAINER_HDR = struct.Struct("<BBHHHII")
+CONTAINER_MAGIC = 0xA5
+CONTAINER_VERSION = 1
+FLAG_DICT = 1 << 0
+FLAG_LZ4 = 1 << 1
+
+BLOCK_HDR = struct.Struct("<HH")
+
+
+def read_hex_export(path):
+    """Collect the hex lines from a captured shell export."""
+    data = bytearray()
+    with open(path, "r", encoding="utf-8", errors="ignore") as f:
+        for line in f:
+            line = line.strip()
+            if line and len(line) % 2 == 0 and HEX_LINE_RE.match(line):
+                data.extend(bytes.fromhex(line))
+    return bytes(data)
+
+
+def iter_entries(data):
+    """Yield the FCB entries of a length-prefixed raw dump."""
+    pos = 0
+    while pos + 2 <= len(data):
+        (length,) = struct.unpack_from("<H", data, pos)
+        pos += 2
+        if pos + length > len(data):
+            raise ValueError(f"Truncated entry at offset {pos - 2}")
+        yield data[pos:pos + length]
+        pos += length
+
+
+def lz4_expand(payload):
+    """Expand the chained LZ4 blocks of one container payload."""
+    import lz4.block  # pylint: disable=import-outside-toplevel
+
+    out = bytearray()
+    pos = 0
+    while pos + BLOCK_HDR.size <= len(payload):
+        raw_len, comp_len = BLOCK_HDR.unpack_from(payload, pos)
+        pos += BLOCK_HDR.size
+        block = payload[pos:pos + comp_len]
+        pos += comp_len
+        # Blocks of one container form a single stream: earlier output is the dictionary.
+        out.extend(lz4.block.decompress(block, uncompressed_size=raw_len, dict=bytes(out[-65536:])))
+    return bytes(out)
+
+
+def decode_entry(entry):
+    """Return (flags, header or None, log bytes) for one stored entry."""
+    if len(entry) >= CONTAINER_HDR.size:
+        hdr = CONTAINER_HDR.unpack_from(entry)
+        magic, version, payload_len, _, flags, _, _ = hdr
+        if (magic == CONTAINER_MAGIC and version == CONTAINER_VERSION and
+                payload_len <= len(entry) - CONTAINER_HDR.size):
+            payload = entry[CONTAINER_HDR.size:CONTAINER_HDR.size + payload_len]
+            if flags & FLAG_LZ4:
+                payload = lz4_expand(payload)
+            return flags, hdr, payload
+    return 0, None, entry
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Unpack Zmod raw log storage dumps")
+    parser.add_argument("input", help="Captured 'log_storage export_raw' output or binary dump")
+    parser.add_argument("--binary", action="store_true",
+                        help="Input is a binary dump from zmod_log_storage_fetch_raw()")
+    parser.add_argument("--out", help="Write the recovered log stream here instead of stdout")
+    parser.add_argument("--stats", action="store_true",
+                        help="Print per-container statistics to stderr")
+    args = parser.parse_args()
+
+    if args.binary:
+        with open(args.input, "rb") as f:
+            data = f.read()
+    else:
+        data = read_hex_export(args.input)
+
+    if not data:
+        sys.exit("No entries found in input")
+
+    stored = 0
+    expanded = 0
+    out = bytearray()
+    for entry in iter_entries(data):
+        flags, hdr, payload = decode_entry(entry)
+        stored += len(entry)
+        expanded += len(payload)
+        out.extend(payload)
+        if args.stats and hdr is not None:
+            print(f"container: {hdr[3]} chunks, {len(entry)} -> {len(payload)} bytes, "
+                  f"{hdr[5]}..{hdr[6]} ms, flags 0x{flags:x}", file=sys.stderr)
+
+    if args.stats and expanded:
+        print(f"total: {stored} stored -> {expanded} log bytes "
+              f"(ratio {expanded / max(stored, 1):.2f})", file=sys.stderr)
+
+    if args.out:
+        with open(args.out, "wb") as f:
+            f.write(out)
+    else:
+        sys.stdout.buffer.write(out)
+
+
+if __name__ == "__main__":
+    main()
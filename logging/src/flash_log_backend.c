@@ -19,40 +19,348 @@
 #include <zephyr/logging/log_output.h>
 #include <zephyr/logging/log_ctrl.h>
 #include <zephyr/sys/util.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/sys/crc.h>
+
+#ifdef CONFIG_ZMOD_LOG_STORAGE_FORMAT_DICTIONARY
+#include <zephyr/logging/log_output_dict.h>
+#endif
 
 #define FLASH_LOG_BUFFER_SIZE CONFIG_ZMOD_LOG_STORAGE_BUFFER_SIZE
 
 static uint8_t flash_log_buf[FLASH_LOG_BUFFER_SIZE];
+static bool flash_log_panic_mode;
+#ifdef CONFIG_ZMOD_LOG_STORAGE_PRIORITY_TIER
+static uint8_t flash_log_priority_buf[FLASH_LOG_BUFFER_SIZE];
+#endif
 
 BUILD_ASSERT(FLASH_LOG_BUFFER_SIZE > 0, "Flash log buffer must be positive");
 
-/** @brief Zephyr log_output callback that persists formatted logs. */
-static int prv_flash_log_output_func(uint8_t *data, size_t length, void *ctx)
+#ifdef CONFIG_ZMOD_LOG_STORAGE_FORMAT_DICTIONARY
+#define FLASH_LOG_DICT_LEN_SIZE (2U) /* u16 little-endian length stored before each message */
+
+BUILD_ASSERT(FLASH_LOG_BUFFER_SIZE <= (UINT16_MAX + FLASH_LOG_DICT_LEN_SIZE),
+             "Dictionary message length must fit its u16 prefix");
+
+/**
+ * @brief One dictionary message gathered from the log_output calls that render it.
+ *
+ * The dictionary output writes the header, the package and the data with
+ * separate calls. They are collected in the log_output buffer, which the
+ * dictionary output does not use, and stored as a single record.
+ */
+typedef struct {
+    uint8_t *buf;                              /* Length prefix, then the message */
+    size_t size;                               /* Capacity of buf */
+    size_t len;                                /* Bytes gathered, prefix included */
+    bool overflow;                             /* Message did not fit; it is dropped */
+    int (*store)(const void *buf, size_t len); /* Storage call for the whole record */
+} prv_flash_log_dict_msg_t;
+#endif
+
+#ifdef CONFIG_ZMOD_LOG_STORAGE_DEDUP
+/** @brief Tracks repeats of the last stored message. */
+typedef struct {
+    uint32_t hash;          /* Hash of the last stored message */
+    uint32_t window_start;  /* Uptime (ms) when that message was stored */
+    uint32_t repeats;       /* Copies suppressed since */
+    uint8_t level;          /* Level of the last stored message */
+    bool valid;
+} prv_flash_log_dedup_t;
+
+static prv_flash_log_dedup_t flash_log_dedup;
+static struct k_mutex flash_log_dedup_mutex;       /* Log thread vs. window-end work */
+static struct k_work_delayable flash_log_dedup_work; /* Stores the count when the window ends */
+#endif
+
+#ifdef CONFIG_ZMOD_LOG_STORAGE_FORMAT_DICTIONARY
+static prv_flash_log_dict_msg_t flash_log_dict_msg = {
+    .buf = flash_log_buf,
+    .size = sizeof(flash_log_buf),
+    .store = zmod_log_storage_add_data,
+};
+#ifdef CONFIG_ZMOD_LOG_STORAGE_PRIORITY_TIER
+static prv_flash_log_dict_msg_t flash_log_dict_priority_msg = {
+    .buf = flash_log_priority_buf,
+    .size = sizeof(flash_log_priority_buf),
+    .store = zmod_log_storage_add_priority,
+};
+#endif
+
+/** @brief Start gathering a new dictionary message. */
+static void prv_flash_log_dict_begin(prv_flash_log_dict_msg_t *dict)
 {
-    ARG_UNUSED(ctx);
+    dict->len = FLASH_LOG_DICT_LEN_SIZE;
+    dict->overflow = false;
+}
 
-    int ret = zmod_log_storage_add_data(data, length);
+/** @brief Append one piece of the message being rendered. */
+static void prv_flash_log_dict_gather(prv_flash_log_dict_msg_t *dict, const uint8_t *data, size_t length)
+{
+    if (dict->overflow || (length > (dict->size - dict->len))) {
+        dict->overflow = true;
+        return;
+    }
+
+    memcpy(&dict->buf[dict->len], data, length);
+    dict->len += length;
+}
 
-    if (ret < 0) {
-        return ret;
+/**
+ * @brief Store the gathered message as one length-prefixed record.
+ *
+ * All or nothing: a message that did not fit the buffer, or that storage
+ * rejects, is dropped whole, so every record the decoder sees starts with a
+ * length and a complete message.
+ */
+static void prv_flash_log_dict_store(prv_flash_log_dict_msg_t *dict)
+{
+    if (dict->overflow || (dict->len == FLASH_LOG_DICT_LEN_SIZE)) {
+        return;
     }
 
+    sys_put_le16((uint16_t)(dict->len - FLASH_LOG_DICT_LEN_SIZE), dict->buf);
+    (void)dict->store(dict->buf, dict->len);
+}
+#endif
+
+/**
+ * @brief Zephyr log_output callback that persists formatted logs.
+ *
+ * Always reports the full length as consumed: log_output treats the return
+ * value as a byte count, so storage failures are dropped here rather than
+ * propagated as a negative value. In dictionary format the pieces are only
+ * gathered; prv_flash_log_dict_store() writes the message.
+ */
+static int prv_flash_log_output_func(uint8_t *data, size_t length, void *ctx)
+{
+#ifdef CONFIG_ZMOD_LOG_STORAGE_FORMAT_DICTIONARY
+    prv_flash_log_dict_gather(ctx, data, length);
+#else
+    ARG_UNUSED(ctx);
+
+    (void)zmod_log_storage_add_data(data, length);
+#endif
+
     return (int)length;
 }
 
 LOG_OUTPUT_DEFINE(flash_log_output, prv_flash_log_output_func, flash_log_buf, sizeof(flash_log_buf));
 
-/** @brief Process a log message and route it into flash storage. */
-static void prv_flash_log_backend_process(const struct log_backend *const backend, union log_msg_generic *msg)
+#ifdef CONFIG_ZMOD_LOG_STORAGE_PRIORITY_TIER
+/** @brief Zephyr log_output callback that feeds the priority tier. */
+static int prv_flash_log_priority_output_func(uint8_t *data, size_t length, void *ctx)
 {
-    ARG_UNUSED(backend);
+#ifdef CONFIG_ZMOD_LOG_STORAGE_FORMAT_DICTIONARY
+    prv_flash_log_dict_gather(ctx, data, length);
+#else
+    ARG_UNUSED(ctx);
+
+    (void)zmod_log_storage_add_priority(data, length);
+#endif
+
+    return (int)length;
+}
+
+LOG_OUTPUT_DEFINE(flash_log_priority_output,
+                  prv_flash_log_priority_output_func,
+                  flash_log_priority_buf,
+                  sizeof(flash_log_priority_buf));
+#endif
+
+/**
+ * @brief Render one message through @p output in the configured storage format.
+ *
+ * In dictionary format the message is stored as its raw binary package
+ * (source, level, timestamp, format string address and arguments) instead of
+ * formatted text, in one length-prefixed record; the host decodes it with the
+ * build's dictionary database.
+ */
+static void prv_flash_log_render(const struct log_output *output, struct log_msg *msg)
+{
+#ifdef CONFIG_ZMOD_LOG_STORAGE_FORMAT_DICTIONARY
+    prv_flash_log_dict_msg_t *dict = output->control_block->ctx;
 
+    prv_flash_log_dict_begin(dict);
+    log_dict_output_msg_process(output, msg, 0U);
+    prv_flash_log_dict_store(dict);
+#else
     uint32_t flags = LOG_OUTPUT_FLAG_LEVEL |
                      LOG_OUTPUT_FLAG_TIMESTAMP |
                      LOG_OUTPUT_FLAG_FORMAT_TIMESTAMP |
                      LOG_OUTPUT_FLAG_CRLF_LFONLY;
 
-    log_output_msg_process(&flash_log_output, &msg->log, flags);
+    log_output_msg_process(output, msg, flags);
+#endif
+}
+
+/** @brief Check whether a message of @p level also belongs in the priority tier. */
+static inline bool prv_flash_log_is_priority(uint8_t level)
+{
+#ifdef CONFIG_ZMOD_LOG_STORAGE_PRIORITY_TIER
+    return !flash_log_panic_mode && (level != LOG_LEVEL_NONE) &&
+           (level <= CONFIG_ZMOD_LOG_STORAGE_PRIORITY_TIER_LEVEL);
+#else
+    ARG_UNUSED(level);
+    return false;
+#endif
+}
+
+#ifdef CONFIG_ZMOD_LOG_STORAGE_DEDUP
+/**
+ * @brief Hash what makes a message distinct: source, level, format string and arguments.
+ *
+ * The cbprintf package holds the format string pointer and the argument
+ * values, and not the timestamp, so identical calls hash alike.
+ */
+static uint32_t prv_flash_log_hash(struct log_msg *msg)
+{
+    const void *source = log_msg_get_source(msg);
+    uint8_t level = log_msg_get_level(msg);
+    size_t len;
+    uint32_t hash = crc32_ieee((const uint8_t *)&source, sizeof(source));
+
+    hash = crc32_ieee_update(hash, &level, sizeof(level));
+
+    uint8_t *data = log_msg_get_package(msg, &len);
+
+    hash = crc32_ieee_update(hash, data, len);
+    data = log_msg_get_data(msg, &len);
+
+    return crc32_ieee_update(hash, data, len);
+}
+
+/**
+ * @brief Take the dedup lock unless in panic mode, where nothing else runs.
+ *
+ * @return true if the lock was taken and must be released.
+ */
+static bool prv_flash_log_dedup_lock(void)
+{
+    if (flash_log_panic_mode) {
+        return false;
+    }
+
+    (void)k_mutex_lock(&flash_log_dedup_mutex, K_FOREVER);
+    return true;
+}
+
+/** @brief Store the "repeated N times" line for suppressed copies, if any. Caller holds the dedup lock. */
+static void prv_flash_log_dedup_flush(void)
+{
+    char line[48];
+
+    if (flash_log_dedup.repeats == 0U) {
+        return;
+    }
+
+    int len = snprintk(line, sizeof(line), "--- last message repeated %u times ---\n", flash_log_dedup.repeats);
+
+    (void)zmod_log_storage_add_data(line, (size_t)len);
+    if (prv_flash_log_is_priority(flash_log_dedup.level)) {
+        (void)zmod_log_storage_add_priority(line, (size_t)len);
+    }
+    flash_log_dedup.repeats = 0U;
+}
+
+/**
+ * @brief Decide whether @p msg repeats the last stored message.
+ *
+ * Repeats within CONFIG_ZMOD_LOG_STORAGE_DEDUP_WINDOW_MS of the stored copy
+ * are only counted. A different message, or a repeat after the window,
+ * writes the count first and is then stored as usual.
+ *
+ * @return true if the message should be dropped.
+ */
+static bool prv_flash_log_dedup(struct log_msg *msg)
+{
+    uint32_t hash = prv_flash_log_hash(msg);
+    uint32_t now = k_uptime_get_32();
+
+    bool locked = prv_flash_log_dedup_lock();
+    uint32_t elapsed = now - flash_log_dedup.window_start;
+    bool repeat = flash_log_dedup.valid && (hash == flash_log_dedup.hash) &&
+                  (elapsed < CONFIG_ZMOD_LOG_STORAGE_DEDUP_WINDOW_MS);
+
+    if (repeat) {
+        if ((flash_log_dedup.repeats++ == 0U) && locked) {
+            (void)k_work_schedule(&flash_log_dedup_work, K_MSEC(CONFIG_ZMOD_LOG_STORAGE_DEDUP_WINDOW_MS - elapsed));
+        }
+    } else {
+        prv_flash_log_dedup_flush();
+        flash_log_dedup.hash = hash;
+        flash_log_dedup.window_start = now;
+        flash_log_dedup.level = log_msg_get_level(msg);
+        flash_log_dedup.valid = true;
+    }
+
+    if (locked) {
+        k_mutex_unlock(&flash_log_dedup_mutex);
+    }
+
+    return repeat;
+}
+
+/**
+ * @brief Store the count once the window ends, so a burst before a quiet period or reset keeps it.
+ *
+ * Work left pending from an earlier window checks again when the current one ends.
+ */
+static void prv_flash_log_dedup_work_handler(struct k_work *work)
+{
+    ARG_UNUSED(work);
+
+    if (!prv_flash_log_dedup_lock()) {
+        return;
+    }
+
+    uint32_t elapsed = k_uptime_get_32() - flash_log_dedup.window_start;
+
+    if (elapsed >= CONFIG_ZMOD_LOG_STORAGE_DEDUP_WINDOW_MS) {
+        prv_flash_log_dedup_flush();
+    } else if (flash_log_dedup.repeats > 0U) {
+        (void)k_work_schedule(&flash_log_dedup_work, K_MSEC(CONFIG_ZMOD_LOG_STORAGE_DEDUP_WINDOW_MS - elapsed));
+    }
+
+    k_mutex_unlock(&flash_log_dedup_mutex);
+}
+#endif /* CONFIG_ZMOD_LOG_STORAGE_DEDUP */
+
+/**
+ * @brief Process a log message and route it into flash storage.
+ *
+ * Messages at or above the priority tier severity are stored a second time in
+ * the priority tier. Printk-style messages carry no level and are skipped there.
+ * While the erase budget is exceeded, less severe messages are not stored at all.
+ */
+static void prv_flash_log_backend_process(const struct log_backend *const backend, union log_msg_generic *msg)
+{
+    ARG_UNUSED(backend);
+
+#ifdef CONFIG_ZMOD_LOG_STORAGE_WEAR
+    if (!flash_log_panic_mode && zmod_log_storage_wear_throttled(log_msg_get_level(&msg->log))) {
+        return;
+    }
+#endif
+
+#ifdef CONFIG_ZMOD_LOG_STORAGE_DEDUP
+    if (prv_flash_log_dedup(&msg->log)) {
+        return;
+    }
+#endif
+
+    prv_flash_log_render(&flash_log_output, &msg->log);
+
+#ifdef CONFIG_ZMOD_LOG_STORAGE_PRIORITY_TIER
+    if (prv_flash_log_is_priority(log_msg_get_level(&msg->log))) {
+        prv_flash_log_render(&flash_log_priority_output, &msg->log);
+    }
+#endif
+
+    if (flash_log_panic_mode) {
+        (void)zmod_log_storage_flush();
+    }
 }
 
 /** @brief Initialize backend by priming log storage. */
@@ -60,15 +368,36 @@ static void prv_flash_log_backend_init(const struct log_backend *const backend)
 {
     ARG_UNUSED(backend);
 
+#ifdef CONFIG_ZMOD_LOG_STORAGE_DEDUP
+    k_mutex_init(&flash_log_dedup_mutex);
+    k_work_init_delayable(&flash_log_dedup_work, prv_flash_log_dedup_work_handler);
+#endif
+#ifdef CONFIG_ZMOD_LOG_STORAGE_FORMAT_DICTIONARY
+    log_output_ctx_set(&flash_log_output, &flash_log_dict_msg);
+#ifdef CONFIG_ZMOD_LOG_STORAGE_PRIORITY_TIER
+    log_output_ctx_set(&flash_log_priority_output, &flash_log_dict_priority_msg);
+#endif
+#endif
     zmod_log_storage_init();
 }
 
-/** @brief Flush buffered output during a LOG_PANIC event. */
+/**
+ * @brief Flush buffered and staged output during a LOG_PANIC event.
+ *
+ * Storage switches to panic mode first so the flushed output and every later
+ * message avoid the mutex and FCB rotation.
+ */
 static void prv_flash_log_backend_panic(const struct log_backend *const backend)
 {
     ARG_UNUSED(backend);
 
+    flash_log_panic_mode = true;
+    (void)zmod_log_storage_panic();
     log_output_flush(&flash_log_output);
+#ifdef CONFIG_ZMOD_LOG_STORAGE_DEDUP
+    prv_flash_log_dedup_flush();
+#endif
+    (void)zmod_log_storage_flush();
 }
 
 /** @brief Report dropped messages to the shared log output handler. */
@@ -76,7 +405,13 @@ static void prv_flash_log_backend_dropped(const struct log_backend *const backen
 {
     ARG_UNUSED(backend);
 
+#ifdef CONFIG_ZMOD_LOG_STORAGE_FORMAT_DICTIONARY
+    prv_flash_log_dict_begin(&flash_log_dict_msg);
+    log_dict_output_dropped_process(&flash_log_output, cnt);
+    prv_flash_log_dict_store(&flash_log_dict_msg);
+#else
     log_output_dropped_process(&flash_log_output, cnt);
+#endif
 }
 
 static const struct log_backend_api flash_log_backend_api = {
@@ -87,3 +422,8 @@ static const struct log_backend_api flash_log_backend_api = {
 };
 
 LOG_BACKEND_DEFINE(flash_log_backend, flash_log_backend_api, true);
+
+const struct log_backend *zmod_flash_log_backend_get(void)
+{
+    return &flash_log_backend;
+}
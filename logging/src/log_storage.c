@@ -10,6 +10,7 @@
  */
 
 #include <zmod/log_storage.h>
+#include <zmod/flash_log_backend.h>
 
 #include <errno.h>
 #include <stddef.h>
@@ -19,6 +20,8 @@
 #include <ctype.h>
 #include <stdlib.h>
 
+#include <zephyr/device.h>
+#include <zephyr/devicetree.h>
 #include <zephyr/storage/flash_map.h>
 #include <zephyr/drivers/flash.h>
 #include <zephyr/logging/log.h>
@@ -26,8 +29,17 @@
 #include <zephyr/logging/log_internal.h>
 #include <zephyr/shell/shell.h>
 #include <zephyr/sys/util.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/crc.h>
 #include <zephyr/fs/fcb.h>
 
+#ifdef CONFIG_ZMOD_LOG_STORAGE_COMPRESSION
+#include <lz4.h>
+#endif
+
+#ifdef CONFIG_ZMOD_LOG_STORAGE_WEAR_ZBUS_PUBLISH
+#include <zephyr/zbus/zbus.h>
+#endif
 
 #include <zmod/config_mgr.h>
 #include <zmod/configs.h>
@@ -40,28 +52,524 @@ LOG_MODULE_REGISTER(zmod_log_storage, CONFIG_ZMOD_LOG_STORAGE_LOG_LEVEL);
 #define LOG_STORAGE_SECTOR_SIZE_BYTES (4096U)
 #define LOG_STORAGE_NUM_SECTORS (FIXED_PARTITION_SIZE(LOG_STORAGE_FLASH_LABEL) / LOG_STORAGE_SECTOR_SIZE_BYTES)
 #define LOG_STORAGE_MUTEX_TIMEOUT_MS (200U)
+#define LOG_STORAGE_READ_CURSORS CONFIG_ZMOD_LOG_STORAGE_READ_CURSORS
+#define LOG_STORAGE_SPAN_BOUNCE_SIZE CONFIG_ZMOD_LOG_STORAGE_SPAN_BOUNCE_SIZE
 
 #define LOG_RUNTIME_MIN_LEVEL CONFIG_ZMOD_LOG_STORAGE_MIN_RUNTIME_LEVEL
 
-/** @brief Read cursor state for exported log data. */
+#ifdef CONFIG_ZMOD_LOG_STORAGE_STAGING
+#define LOG_STORAGE_STAGING_RING_SIZE CONFIG_ZMOD_LOG_STORAGE_STAGING_RING_SIZE
+#define LOG_STORAGE_FLUSH_WATERMARK CONFIG_ZMOD_LOG_STORAGE_FLUSH_WATERMARK
+#define LOG_STORAGE_FLUSH_MAX_LATENCY_MS CONFIG_ZMOD_LOG_STORAGE_FLUSH_MAX_LATENCY_MS
+#define LOG_STORAGE_PACK_SIZE CONFIG_ZMOD_LOG_STORAGE_PACK_SIZE
+#define LOG_STORAGE_PACK_MAX_AGE_MS CONFIG_ZMOD_LOG_STORAGE_PACK_MAX_AGE_MS
+#define LOG_STORAGE_FLUSH_THREAD_STACK_SIZE CONFIG_ZMOD_LOG_STORAGE_FLUSH_THREAD_STACK_SIZE
+#define LOG_STORAGE_FLUSH_THREAD_PRIORITY K_PRIO_PREEMPT(CONFIG_ZMOD_LOG_STORAGE_FLUSH_THREAD_PRIORITY)
+
+BUILD_ASSERT(LOG_STORAGE_FLUSH_WATERMARK <= LOG_STORAGE_STAGING_RING_SIZE,
+             "Flush watermark must not exceed the staging ring size");
+BUILD_ASSERT(IS_POWER_OF_TWO(LOG_STORAGE_STAGING_RING_SIZE),
+             "Staging ring size must be a power of two");
+BUILD_ASSERT(LOG_STORAGE_PACK_SIZE <= LOG_STORAGE_SECTOR_SIZE_BYTES,
+             "Packed container cannot exceed one FCB sector");
+#endif
+
+#ifdef CONFIG_ZMOD_LOG_STORAGE_COMPRESSION
+#define LOG_STORAGE_COMPRESS_WINDOW CONFIG_ZMOD_LOG_STORAGE_COMPRESSION_WINDOW
+#define LOG_STORAGE_COMPRESS_BLOCK (512U)
+#define LOG_STORAGE_COMPRESS_BLOCK_HDR (4U)
+#define LOG_STORAGE_COMPRESS_SCRATCH LZ4_COMPRESSBOUND(LOG_STORAGE_COMPRESS_BLOCK + LOG_STORAGE_STAGING_MAX_CHUNK)
+
+BUILD_ASSERT(LOG_STORAGE_COMPRESS_WINDOW >= LOG_STORAGE_PACK_SIZE,
+             "Compression window must hold at least one uncompressed container");
+BUILD_ASSERT(LOG_STORAGE_PACK_SIZE >= 1024U,
+             "Compressed containers need room for at least one full block");
+#endif
+
+#define LOG_STORAGE_CONTAINER_MAGIC (0xA5U)
+#define LOG_STORAGE_CONTAINER_VERSION (1U)
+#define LOG_STORAGE_CONTAINER_FLAG_DICT BIT(0)
+#define LOG_STORAGE_CONTAINER_FLAG_LZ4 BIT(1)
+#define LOG_STORAGE_STAGING_MAX_CHUNK (128U)
+#define LOG_STORAGE_FCB_SECTOR_HDR_BYTES (8U)
+#define LOG_STORAGE_FCB_LEN_BYTES (2U)
+#define LOG_STORAGE_FCB_CRC_BYTES (1U)
+#define LOG_STORAGE_FCB_ID_OFF (6U)
+
+/* Staging ring records: an atomic_t header word followed by the data, padded to the header size. */
+#define LOG_STORAGE_RING_HDR sizeof(atomic_t)
+#define LOG_STORAGE_RING_LEN_MASK (0xFFFFU)
+#define LOG_STORAGE_RING_PAD BIT(16)       /* Skip to the start of the ring */
+#define LOG_STORAGE_RING_COMMITTED BIT(17) /* Producer finished writing the record */
+#define LOG_STORAGE_RING_PRIORITY BIT(18)  /* Record goes to the priority tier */
+#define LOG_STORAGE_RING_MASK (LOG_STORAGE_STAGING_RING_SIZE - 1U)
+/* Bounded so a record always fits once the ring drains, wherever the head is. */
+#define LOG_STORAGE_RING_MAX_RECORD ((LOG_STORAGE_STAGING_RING_SIZE / 2U) - LOG_STORAGE_RING_HDR)
+
+#ifdef CONFIG_ZMOD_LOG_STORAGE_FAST_MOUNT
+#define LOG_STORAGE_META_SECTORS (1U)
+#else
+#define LOG_STORAGE_META_SECTORS (0U)
+#endif
+#define LOG_STORAGE_META_MAGIC (0x4C4D4554U)
+#define LOG_STORAGE_META_PROBE_BYTES (16U)
+
+#ifdef CONFIG_ZMOD_LOG_STORAGE_PANIC_SECTOR
+#define LOG_STORAGE_PANIC_SECTORS (1U)
+#else
+#define LOG_STORAGE_PANIC_SECTORS (0U)
+#endif
+#define LOG_STORAGE_PANIC_MAGIC (0x434E504CU)
+#define LOG_STORAGE_PANIC_MAGIC_BYTES (4U)
+#define LOG_STORAGE_PANIC_BUF_SIZE (64U) /* Also the largest write block the panic writer supports */
+
+#ifdef CONFIG_ZMOD_LOG_STORAGE_PRIORITY_TIER
+#define LOG_STORAGE_PRIORITY_SECTORS CONFIG_ZMOD_LOG_STORAGE_PRIORITY_TIER_SECTORS
+#else
+#define LOG_STORAGE_PRIORITY_SECTORS (0U)
+#endif
+#define LOG_STORAGE_PRIORITY_FCB_MAGIC (0x1EE7E440U)
+#define LOG_STORAGE_PRIORITY_CHUNK (256U) /* Longer priority records are split across containers */
+
+#ifdef CONFIG_ZMOD_LOG_STORAGE_WEAR
+#define LOG_STORAGE_WEAR_WINDOW_S (24U * 60U * 60U) /* Budget window, in powered time */
+#define LOG_STORAGE_WEAR_SAVE_ERASES CONFIG_ZMOD_LOG_STORAGE_WEAR_SAVE_ERASES
+#define LOG_STORAGE_WEAR_ENDURANCE CONFIG_ZMOD_LOG_STORAGE_WEAR_ENDURANCE
+#define LOG_STORAGE_WEAR_BUDGET CONFIG_ZMOD_LOG_STORAGE_WEAR_BUDGET_PER_DAY
+#define LOG_STORAGE_WEAR_THROTTLE_LEVEL CONFIG_ZMOD_LOG_STORAGE_WEAR_THROTTLE_LEVEL
+#define LOG_STORAGE_WEAR_RETRY_MS (1000U)
+
+BUILD_ASSERT(LOG_STORAGE_NUM_SECTORS <= CONFIG_ZMOD_LOG_STORAGE_WEAR_MAX_SECTORS,
+             "ZMOD_LOG_STORAGE_WEAR_MAX_SECTORS must cover the logging partition");
+
+#ifdef CONFIG_ZMOD_CONFIG_USE_CUSTOM_TYPES
+#include CONFIG_ZMOD_CONFIG_TYPES_DEF_PATH
+#endif
+
+/* The application's .def file must define CFG_LOG_STORAGE_WEAR; without it the assert fails to compile */
+#define CFG_DEFINE(key, type, default_val, rst) typedef type log_storage_cfg_##key##_t;
+#include CONFIG_ZMOD_CONFIG_APP_DEF_PATH
+#undef CFG_DEFINE
+BUILD_ASSERT(__builtin_types_compatible_p(log_storage_cfg_CFG_LOG_STORAGE_WEAR_t, zmod_log_storage_wear_t),
+             "CFG_LOG_STORAGE_WEAR must be defined in the app .def file with type zmod_log_storage_wear_t");
+
+#ifdef CONFIG_ZMOD_LOG_STORAGE_WEAR_ZBUS_PUBLISH
+ZBUS_CHAN_DEFINE(zmod_log_storage_wear_chan,
+                 struct zmod_log_storage_wear_event,
+                 NULL,
+                 NULL,
+                 ZBUS_OBSERVERS_EMPTY,
+                 ZBUS_MSG_INIT(0));
+#endif
+#endif
+
+#ifdef CONFIG_ZMOD_LOG_STORAGE_RETAINED_RAM
+#define LOG_STORAGE_RETAINED_SIZE CONFIG_ZMOD_LOG_STORAGE_RETAINED_RAM_SIZE
+#define LOG_STORAGE_RETAINED_MAGIC (0x524C4F47U)
+
+BUILD_ASSERT(IS_POWER_OF_TWO(LOG_STORAGE_RETAINED_SIZE), "Retained log ring size must be a power of two");
+#endif
+
+/* Sectors at the end of the partition that are not handed to the main FCB: priority tier, panic area, journal. */
+#define LOG_STORAGE_RESERVED_SECTORS \
+    (LOG_STORAGE_PRIORITY_SECTORS + LOG_STORAGE_PANIC_SECTORS + LOG_STORAGE_META_SECTORS)
+
+/* FCB sector ids wrap; same comparison the FCB uses internally. */
+#define LOG_STORAGE_FCB_ID_GT(a, b) (((int16_t)(a) - (int16_t)(b)) > 0)
+
+BUILD_ASSERT(sizeof(zmod_log_storage_metadata_t) == 32U,
+             "Metadata journal slots are written as one 32-byte block");
+
+/**
+ * @brief Header of a packed container record.
+ *
+ * The flusher concatenates many staged log chunks into one FCB entry laid out
+ * as this header followed by @p payload_len bytes of log data. Entries that do
+ * not start with a valid header are treated as raw, unpacked log data.
+ *
+ * With LOG_STORAGE_CONTAINER_FLAG_LZ4 set the payload is a sequence of blocks,
+ * each a little-endian u16 raw length, u16 compressed length and that many
+ * bytes of LZ4 block data. Blocks of one container form a single LZ4 stream:
+ * later blocks reference data decoded from earlier ones.
+ *
+ * Timestamps use the log clock: milliseconds of uptime continued across
+ * reboots from the newest stored container, so they never go backwards.
+ */
+typedef struct __packed {
+    uint8_t magic;          /* LOG_STORAGE_CONTAINER_MAGIC */
+    uint8_t version;        /* LOG_STORAGE_CONTAINER_VERSION */
+    uint16_t payload_len;   /* Log bytes following the header */
+    uint16_t record_count;  /* Number of staged chunks packed into the container */
+    uint16_t flags;         /* LOG_STORAGE_CONTAINER_FLAG_* */
+    uint32_t first_ts_ms;   /* Log time when the first chunk was packed */
+    uint32_t last_ts_ms;    /* Log time when the last chunk was packed */
+} prv_log_container_hdr_t;
+
+/** @brief Where the log payload of one FCB entry lives. */
+typedef struct {
+    uint16_t off;           /* Offset of the stored payload inside the entry */
+    uint16_t stored_len;    /* Stored payload bytes (compressed size for LZ4 containers) */
+    uint16_t len;           /* Log bytes the payload expands to */
+    uint16_t flags;         /* Container flags, 0 for raw entries */
+} prv_entry_info_t;
+
+/** @brief Optional log-clock window applied to a read. */
+typedef struct {
+    bool active;
+    uint32_t since_ms;
+    uint32_t until_ms;
+} prv_time_range_t;
+
+/** @brief Per-sector summary of the entries it holds. */
 typedef struct {
+    uint32_t first_ts_ms;     /* Valid when container_count is non-zero */
+    uint32_t last_ts_ms;
+    uint32_t container_count; /* Entries that carry timestamps */
+    uint32_t record_count;    /* Records: staged chunks of each container, 1 per raw entry */
+    uint32_t log_bytes;       /* Log bytes across all entries, expanded */
+} prv_sector_index_t;
+
+/** @brief Read cursor state for exported log data. */
+typedef struct zmod_log_storage_read_ctx {
+    struct fcb *fcb;        /* Tier the cursor reads */
     struct fcb_entry head;
+    prv_entry_info_t info;  /* Payload location of the entry at head */
     size_t read_bytes;
+    prv_time_range_t range; /* Set by zmod_log_storage_seek_time() */
+    struct fcb_entry end;   /* Append position the read stops at when bounded */
+    bool bounded;
+    bool at_end;            /* Reached the end marker */
+    bool stale;             /* Position was rotated out since the last fetch */
+    bool in_use;            /* Pool cursor is open; unused for read_head */
+    uint32_t skip_bytes;    /* Log bytes to drop before the first fetch, set by a tail seek */
+    const struct flash_sector *span_sector; /* Sector an in-place span points into; not rotated out */
+    uint8_t bounce[LOG_STORAGE_SPAN_BOUNCE_SIZE]; /* Span data when flash is not memory-mapped */
 } zmod_log_storage_read_ctx_t;
 
+#ifdef CONFIG_ZMOD_LOG_STORAGE_RETAINED_RAM
+/**
+ * @brief Mirror of recent staged log bytes kept in RAM that survives warm resets.
+ *
+ * Positions are free-running byte counts. Bytes between @p flushed and
+ * @p head had been staged but not yet written to flash when the device
+ * reset. The CRC covers only the fixed fields, so producers never update it.
+ */
+typedef struct {
+    uint32_t magic;         /* LOG_STORAGE_RETAINED_MAGIC */
+    uint32_t size;          /* LOG_STORAGE_RETAINED_SIZE */
+    uint32_t crc;           /* CRC32 of magic and size */
+    atomic_t head;          /* Bytes ever mirrored */
+    atomic_t flushed;       /* Mirrored bytes that have left the staging path */
+    uint8_t data[LOG_STORAGE_RETAINED_SIZE];
+} prv_retained_ring_t;
+
+static prv_retained_ring_t prv_retained __noinit;
+#endif
+
+/** @brief Counters behind zmod_log_storage_get_stats(), since boot. */
+typedef struct {
+    uint64_t bytes_written;                /* FCB entry payload bytes, both tiers */
+    uint32_t records_written;              /* FCB entries appended, both tiers */
+    uint32_t rotations;                    /* fcb_rotate() calls, both tiers */
+    uint32_t erases[LOG_STORAGE_NUM_SECTORS]; /* Sector erases issued by this module */
+    atomic_t mutex_timeouts;               /* Storage mutex not obtained within the timeout */
+    atomic_t export_dropped;               /* Records refused while an export snapshot was active */
+    uint64_t fetch_bytes;                  /* Bytes returned by fetch calls */
+    uint32_t append_cycles_max;            /* Slowest main-tier append, mutex wait included */
+    uint64_t append_cycles_total;
+    uint32_t append_count;
+} prv_log_storage_stats_t;
+
 /** @brief Internal module state. */
 typedef struct {
     const struct flash_area *fa;
     struct fcb fcb_inst;
     struct flash_sector sectors[LOG_STORAGE_NUM_SECTORS];
-    zmod_log_storage_metadata_t metadata;
+    zmod_log_storage_metadata_t metadata;  /* Last record written to the journal */
+#ifdef CONFIG_ZMOD_LOG_STORAGE_FAST_MOUNT
+    struct flash_sector *meta_sector;      /* Journal sector, outside the FCB */
+    uint32_t meta_slot;                    /* Next journal slot to program */
+#endif
+#ifdef CONFIG_ZMOD_LOG_STORAGE_PANIC_SECTOR
+    struct flash_sector *panic_sector;     /* Pre-erased sector for panic-time writes, outside the FCB */
+    uint32_t panic_off;                    /* Next write offset inside panic_sector */
+    uint8_t panic_buf[LOG_STORAGE_PANIC_BUF_SIZE]; /* Assembles whole flash write blocks */
+    size_t panic_fill;                     /* Bytes in panic_buf */
+    atomic_t panic_dropped;                /* Bytes that did not fit in the panic sector */
+    volatile bool panic;                   /* Writes bypass the mutex and go to panic_sector */
+#endif
+#ifdef CONFIG_ZMOD_LOG_STORAGE_PRIORITY_TIER
+    struct fcb priority_fcb;               /* High-severity tier on its own reserved sectors */
+    uint8_t priority_buf[sizeof(prv_log_container_hdr_t) + LOG_STORAGE_PRIORITY_CHUNK];
+#endif
     struct k_mutex mutex;
-    zmod_log_storage_read_ctx_t read_head;
+    prv_log_storage_stats_t stats;
+    zmod_log_storage_read_ctx_t read_head; /* Cursor behind the zmod_log_storage_fetch_*() calls */
+    zmod_log_storage_read_ctx_t cursors[LOG_STORAGE_READ_CURSORS];
     volatile bool export_in_progress;
+    bool snapshot_active;                  /* read_head is exporting a frozen snapshot */
+#ifdef CONFIG_ZMOD_LOG_STORAGE_STAGING
+    uint8_t staging_buf[LOG_STORAGE_STAGING_RING_SIZE] __aligned(sizeof(atomic_t));
+    atomic_t ring_head;                    /* Reservation position, advanced by producers */
+    atomic_t ring_tail;                    /* Consumption position, advanced by the flusher only */
+    struct k_sem flush_sem;                /* Signalled when the ring crosses the watermark */
+    struct k_thread flush_thread;
+    atomic_t ring_dropped_records;         /* Reservations refused because the ring was full */
+    atomic_t ring_dropped_bytes;
+    atomic_t staging_dropped;              /* Staged bytes lost to flash write failures */
+    prv_log_container_hdr_t pack_hdr;      /* Header of the container being filled */
+    uint8_t pack_buf[LOG_STORAGE_PACK_SIZE]; /* Container header followed by packed payload */
+    uint16_t pack_capacity;                /* Payload bytes that fit in one container */
+    bool pack_blocked;                     /* Container held back by a pinned snapshot sector */
+    size_t ring_off;                       /* Bytes of the oldest ring record already packed */
+    uint32_t time_base_ms;                 /* Log clock minus uptime for this boot */
+#endif
+#ifdef CONFIG_ZMOD_LOG_STORAGE_TIME_INDEX
+    prv_sector_index_t index[LOG_STORAGE_NUM_SECTORS]; /* Built on first time or tail query */
+    bool index_valid;
+#endif
+#ifdef CONFIG_ZMOD_LOG_STORAGE_COMPRESSION
+    LZ4_stream_t lz4_stream;               /* Compressor state for the open container */
+    uint8_t pack_raw[LOG_STORAGE_COMPRESS_WINDOW]; /* Uncompressed data of the open container */
+    uint16_t raw_len;                      /* Bytes in pack_raw */
+    uint16_t raw_done;                     /* Leading bytes of pack_raw already compressed */
+    prv_log_container_hdr_t pack_pending;  /* Chunk stats for pack_raw bytes not yet compressed */
+    uint8_t decomp_buf[LOG_STORAGE_COMPRESS_WINDOW]; /* Decompressed payload of decomp_entry */
+    uint8_t decomp_scratch[LOG_STORAGE_COMPRESS_SCRATCH]; /* One compressed block read from flash */
+    struct fcb_entry decomp_entry;         /* Entry cached in decomp_buf */
+    uint16_t decomp_len;
+    bool decomp_valid;
+    uint64_t raw_total;                    /* Bytes fed to the compressor since boot */
+    uint64_t compressed_total;             /* Bytes the compressor produced since boot */
+#endif
+#ifdef CONFIG_ZMOD_LOG_STORAGE_WEAR
+    zmod_log_storage_wear_t wear;          /* Persisted wear record plus the erases since */
+    zmod_log_storage_wear_t wear_saved;    /* Copy being loaded or saved by wear_work */
+    uint32_t wear_uptime_base_s;           /* Powered time before this boot */
+    atomic_t wear_unsaved;                 /* Erases since the record was last saved */
+    atomic_t wear_level;                   /* Least severe level stored, 0 while not throttled */
+    atomic_t wear_dropped;                 /* Messages dropped by the throttle */
+    bool wear_config_ready;                /* Config store readable, set by zmod_log_storage_init_log_level() */
+    bool wear_loaded;                      /* Persisted record merged into wear */
+    struct k_work_delayable wear_work;     /* Loads and saves the record, re-evaluates the budget */
+#endif
 } prv_log_storage_state_t;
 
 static prv_log_storage_state_t prv_inst;
 
+#ifdef CONFIG_ZMOD_LOG_STORAGE_STAGING
+static K_THREAD_STACK_DEFINE(prv_flush_thread_stack, LOG_STORAGE_FLUSH_THREAD_STACK_SIZE);
+
+static void prv_flush_thread(void *p1, void *p2, void *p3);
+static uint16_t prv_pack_capacity(void);
+static void prv_log_time_init(void);
+#endif
+#ifdef CONFIG_ZMOD_LOG_STORAGE_PANIC_SECTOR
+static void prv_panic_recover(void);
+#endif
+#ifdef CONFIG_ZMOD_LOG_STORAGE_RETAINED_RAM
+static void prv_retained_recover(void);
+#endif
+
+/** @brief Take the storage mutex with the standard timeout, counting timeouts. */
+static int prv_lock(void)
+{
+    int ret = k_mutex_lock(&prv_inst.mutex, K_MSEC(LOG_STORAGE_MUTEX_TIMEOUT_MS));
+
+    if (ret < 0) {
+        atomic_inc(&prv_inst.stats.mutex_timeouts);
+    }
+
+    return ret;
+}
+
+#ifdef CONFIG_ZMOD_LOG_STORAGE_WEAR
+/** @brief Powered time covered by the wear record, in seconds. */
+static uint32_t prv_wear_uptime(void)
+{
+    return prv_inst.wear_uptime_base_s + (uint32_t)(k_uptime_get() / MSEC_PER_SEC);
+}
+
+/** @brief Open a new budget window once the current one has run a day. Caller holds the mutex. */
+static void prv_wear_window_roll(uint32_t now_s)
+{
+    if ((now_s - prv_inst.wear.window_start_s) >= LOG_STORAGE_WEAR_WINDOW_S) {
+        prv_inst.wear.window_start_s = now_s;
+        prv_inst.wear.window_erases = 0U;
+    }
+}
+
+/** @brief Count a lifetime erase of sector @p index, saving the record every few erases. */
+static void prv_wear_erase(size_t index)
+{
+    prv_wear_window_roll(prv_wear_uptime());
+    prv_inst.wear.erases[index]++;
+    prv_inst.wear.window_erases++;
+
+    bool over_budget = (LOG_STORAGE_WEAR_BUDGET > 0U) && (prv_inst.wear.window_erases > LOG_STORAGE_WEAR_BUDGET) &&
+                       (atomic_get(&prv_inst.wear_level) == 0);
+
+    if ((atomic_inc(&prv_inst.wear_unsaved) + 1 >= LOG_STORAGE_WEAR_SAVE_ERASES) || over_budget) {
+        (void)k_work_reschedule(&prv_inst.wear_work, K_NO_WAIT);
+    }
+}
+
+/**
+ * @brief Summarize @p wear as of @p now_s.
+ *
+ * FCB rotation wears the sectors in turn, so the most worn sector decides the
+ * lifetime. The projection extrapolates its average erase rate over the
+ * powered time on record.
+ */
+static void prv_wear_summarize(const zmod_log_storage_wear_t *wear, uint32_t now_s,
+                               struct zmod_log_storage_wear_event *evt)
+{
+    memset(evt, 0, sizeof(*evt));
+    evt->uptime_s = now_s;
+    evt->window_erases = wear->window_erases;
+    evt->lifetime_days = UINT32_MAX;
+
+    for (size_t i = 0U; i < LOG_STORAGE_NUM_SECTORS; i++) {
+        evt->total_erases += wear->erases[i];
+        evt->max_erases = MAX(evt->max_erases, wear->erases[i]);
+    }
+
+    if (evt->max_erases >= LOG_STORAGE_WEAR_ENDURANCE) {
+        evt->lifetime_days = 0U;
+    } else if (evt->max_erases > 0U) {
+        uint64_t remaining_s = ((uint64_t)(LOG_STORAGE_WEAR_ENDURANCE - evt->max_erases) * now_s) / evt->max_erases;
+
+        evt->lifetime_days = (uint32_t)MIN(remaining_s / LOG_STORAGE_WEAR_WINDOW_S, (uint64_t)UINT32_MAX);
+    }
+
+    evt->throttle_level = (uint8_t)atomic_get(&prv_inst.wear_level);
+    evt->dropped = (uint32_t)atomic_get(&prv_inst.wear_dropped);
+}
+
+/**
+ * @brief Merge the persisted wear record into the counts taken since boot.
+ *
+ * Runs once the config store is ready. A record written for a different
+ * partition layout is discarded.
+ */
+static void prv_wear_load(void)
+{
+    zmod_log_storage_wear_t *stored = &prv_inst.wear_saved;
+
+    if (!zmod_config_mgr_get_value(CFG_LOG_STORAGE_WEAR, stored, sizeof(*stored)) ||
+        (stored->sector_count != LOG_STORAGE_NUM_SECTORS)) {
+        memset(stored, 0, sizeof(*stored));
+        stored->sector_count = LOG_STORAGE_NUM_SECTORS;
+    }
+
+    (void)k_mutex_lock(&prv_inst.mutex, K_FOREVER);
+
+    for (size_t i = 0U; i < LOG_STORAGE_NUM_SECTORS; i++) {
+        stored->erases[i] += prv_inst.wear.erases[i];
+    }
+    stored->window_erases += prv_inst.wear.window_erases;
+    prv_inst.wear_uptime_base_s = stored->uptime_s;
+    prv_inst.wear = *stored;
+    prv_inst.wear_loaded = true;
+
+    k_mutex_unlock(&prv_inst.mutex);
+}
+
+/**
+ * @brief Load or save the wear record and apply the erase budget.
+ *
+ * The config store write happens outside the storage mutex. Subscribers hear
+ * of every save and of every throttle change.
+ */
+static void prv_wear_work_handler(struct k_work *work)
+{
+    ARG_UNUSED(work);
+
+    zmod_log_storage_wear_t *record = &prv_inst.wear_saved;
+
+    if (prv_inst.wear_config_ready && !prv_inst.wear_loaded) {
+        prv_wear_load();
+    }
+
+    if (prv_lock() < 0) {
+        (void)k_work_reschedule(&prv_inst.wear_work, K_MSEC(LOG_STORAGE_WEAR_RETRY_MS));
+        return;
+    }
+
+    uint32_t now_s = prv_wear_uptime();
+    atomic_val_t unsaved = atomic_get(&prv_inst.wear_unsaved);
+
+    prv_wear_window_roll(now_s);
+    *record = prv_inst.wear;
+    record->uptime_s = now_s;
+
+    k_mutex_unlock(&prv_inst.mutex);
+
+    bool saved = prv_inst.wear_loaded && (unsaved > 0) &&
+                 zmod_config_mgr_set_value(CFG_LOG_STORAGE_WEAR, record, sizeof(*record));
+
+    if (saved) {
+        (void)atomic_sub(&prv_inst.wear_unsaved, unsaved);
+    }
+
+    bool over_budget = (LOG_STORAGE_WEAR_BUDGET > 0U) && (record->window_erases > LOG_STORAGE_WEAR_BUDGET);
+    atomic_val_t level = over_budget ? LOG_STORAGE_WEAR_THROTTLE_LEVEL : 0;
+    bool changed = (atomic_set(&prv_inst.wear_level, level) != level);
+
+    if (changed) {
+        if (over_budget) {
+            LOG_WRN("Erase budget exceeded (%u erases today); storing level %u and above",
+                    record->window_erases, (unsigned int)level);
+        } else {
+            LOG_INF("Erase budget window reopened; storing all levels");
+        }
+    }
+
+    if (over_budget) {
+        /* Nothing else may erase while throttled; reopen the window on time. */
+        (void)k_work_reschedule(&prv_inst.wear_work,
+                                K_SECONDS(LOG_STORAGE_WEAR_WINDOW_S - (now_s - record->window_start_s)));
+    }
+
+#ifdef CONFIG_ZMOD_LOG_STORAGE_WEAR_ZBUS_PUBLISH
+    if (saved || changed) {
+        struct zmod_log_storage_wear_event evt;
+
+        prv_wear_summarize(record, now_s, &evt);
+
+        int ret = zbus_chan_pub(&zmod_log_storage_wear_chan, &evt, K_NO_WAIT);
+        if (ret != 0) {
+            LOG_WRN("Failed to publish wear event: %d", ret);
+        }
+    }
+#endif
+}
+#endif /* CONFIG_ZMOD_LOG_STORAGE_WEAR */
+
+/** @brief Count an erase of @p sector. */
+static void prv_stats_erase(const struct flash_sector *sector)
+{
+    prv_inst.stats.erases[sector - prv_inst.sectors]++;
+#ifdef CONFIG_ZMOD_LOG_STORAGE_WEAR
+    prv_wear_erase(sector - prv_inst.sectors);
+#endif
+}
+
+/** @brief Count the erase of every sector of @p fcb by fcb_clear(). */
+static void prv_stats_clear(const struct fcb *fcb)
+{
+    for (uint8_t i = 0U; i < fcb->f_sector_cnt; i++) {
+        prv_stats_erase(&fcb->f_sectors[i]);
+    }
+}
+
+/** @brief Count one appended FCB entry. Caller holds the mutex. */
+static void prv_stats_append(size_t len)
+{
+    prv_inst.stats.bytes_written += len;
+    prv_inst.stats.records_written++;
+}
+
 /** @brief Convert a Zephyr log severity level to a printable name. */
 static const char *prv_get_log_level_name(uint8_t level)
 {
@@ -127,6 +635,226 @@ static const prv_log_level_entry_t *prv_find_log_level(const char *name)
     return NULL;
 }
 
+#ifdef CONFIG_ZMOD_LOG_STORAGE_FAST_MOUNT
+/** @brief Read the on-flash FCB header of @p sector. */
+static int prv_sector_hdr_read(const struct flash_sector *sector, uint8_t *hdr)
+{
+    return flash_area_read(prv_inst.fa, sector->fs_off, hdr, LOG_STORAGE_FCB_SECTOR_HDR_BYTES);
+}
+
+static uint32_t prv_meta_crc(const zmod_log_storage_metadata_t *meta)
+{
+    return crc32_ieee((const uint8_t *)meta, offsetof(zmod_log_storage_metadata_t, crc));
+}
+
+/** @brief Check whether a journal slot has never been programmed. */
+static bool prv_meta_slot_erased(uint32_t slot)
+{
+    uint8_t magic[sizeof(uint32_t)];
+    uint8_t erased[sizeof(uint32_t)];
+    uint32_t off = prv_inst.meta_sector->fs_off + (slot * sizeof(zmod_log_storage_metadata_t));
+
+    memset(erased, flash_area_erased_val(prv_inst.fa), sizeof(erased));
+
+    if (flash_area_read(prv_inst.fa, off, magic, sizeof(magic)) < 0) {
+        return false;
+    }
+
+    return memcmp(magic, erased, sizeof(magic)) == 0;
+}
+
+/**
+ * @brief Load the newest journal record into prv_inst.metadata.
+ *
+ * Slots are programmed in order, so the first erased one is found by
+ * bisection and the record before it is the newest.
+ */
+static int prv_meta_load(void)
+{
+    uint32_t lo = 0U;
+    uint32_t hi = prv_inst.meta_sector->fs_size / sizeof(zmod_log_storage_metadata_t);
+
+    while (lo < hi) {
+        uint32_t mid = lo + ((hi - lo) / 2U);
+
+        if (prv_meta_slot_erased(mid)) {
+            hi = mid;
+        } else {
+            lo = mid + 1U;
+        }
+    }
+
+    prv_inst.meta_slot = lo;
+
+    if (lo == 0U) {
+        return -ENOENT;
+    }
+
+    zmod_log_storage_metadata_t *meta = &prv_inst.metadata;
+    int ret = flash_area_read(prv_inst.fa,
+                              prv_inst.meta_sector->fs_off + ((lo - 1U) * sizeof(*meta)),
+                              meta,
+                              sizeof(*meta));
+
+    if (ret < 0) {
+        return ret;
+    }
+
+    if ((meta->magic != LOG_STORAGE_META_MAGIC) || (meta->crc != prv_meta_crc(meta))) {
+        /* Not a journal (e.g. former FCB data): erase before the next record. */
+        memset(meta, 0, sizeof(*meta));
+        prv_inst.meta_slot = prv_inst.meta_sector->fs_size / sizeof(*meta);
+        return -EBADMSG;
+    }
+
+    return 0;
+}
+
+/* FCB has no call to adopt a known oldest sector; fail the build if that member changes shape. */
+BUILD_ASSERT(__builtin_types_compatible_p(__typeof__(((struct fcb *)0)->f_oldest), struct flash_sector *),
+             "struct fcb layout changed; review prv_meta_mount()");
+
+/**
+ * @brief Restore FCB state from the journal instead of scanning every sector.
+ *
+ * The cached head and tail headers must still match flash, the sector after
+ * the tail must not have been started since, and the tail must end in erased
+ * flash. fcb_init() then mounts the tail sector alone, which sets up the
+ * flash area, alignment, lock and append position, and the full sector set is
+ * restored afterwards. Any mismatch returns an error with the full sector set
+ * in place and the caller runs fcb_init() over every sector.
+ */
+static int prv_meta_mount(void)
+{
+    struct fcb *fcb = &prv_inst.fcb_inst;
+    const zmod_log_storage_metadata_t *meta = &prv_inst.metadata;
+    uint8_t hdr[LOG_STORAGE_FCB_SECTOR_HDR_BYTES];
+    uint8_t sector_cnt = fcb->f_sector_cnt;
+    uint8_t scratch_cnt = fcb->f_scratch_cnt;
+
+    int ret = prv_meta_load();
+
+    if (ret < 0) {
+        return ret;
+    }
+
+    if ((meta->head_sector >= fcb->f_sector_cnt) || (meta->tail_sector >= fcb->f_sector_cnt)) {
+        return -EINVAL;
+    }
+
+    struct flash_sector *head = &prv_inst.sectors[meta->head_sector];
+    struct flash_sector *tail = &prv_inst.sectors[meta->tail_sector];
+    struct flash_sector *next = &prv_inst.sectors[(meta->tail_sector + 1U) % fcb->f_sector_cnt];
+
+    ret = prv_sector_hdr_read(head, hdr);
+    if ((ret < 0) || (memcmp(hdr, meta->head_hdr, sizeof(hdr)) != 0)) {
+        return -ESTALE;
+    }
+
+    ret = prv_sector_hdr_read(tail, hdr);
+    if ((ret < 0) || (memcmp(hdr, meta->tail_hdr, sizeof(hdr)) != 0)) {
+        return -ESTALE;
+    }
+
+    /* A tail move that never reached the journal leaves a newer header after the tail. */
+    uint16_t tail_id = sys_get_le16(&meta->tail_hdr[LOG_STORAGE_FCB_ID_OFF]);
+
+    ret = prv_sector_hdr_read(next, hdr);
+    if ((ret < 0) ||
+        ((memcmp(hdr, meta->tail_hdr, sizeof(uint32_t)) == 0) &&
+         LOG_STORAGE_FCB_ID_GT(sys_get_le16(&hdr[LOG_STORAGE_FCB_ID_OFF]), tail_id))) {
+        return -ESTALE;
+    }
+
+    /* Only the tail sector is scanned and walked to find the append position. */
+    fcb->f_sectors = tail;
+    fcb->f_sector_cnt = 1U;
+    fcb->f_scratch_cnt = 0U;
+
+    ret = fcb_init(LOG_STORAGE_FLASH_AREA_ID, fcb);
+
+    fcb->f_sectors = prv_inst.sectors;
+    fcb->f_sector_cnt = sector_cnt;
+    fcb->f_scratch_cnt = scratch_cnt;
+
+    if (ret < 0) {
+        return ret;
+    }
+
+    if ((fcb->f_active.fe_sector != tail) || (fcb->f_active_id != tail_id)) {
+        return -ESTALE;
+    }
+
+    fcb->f_oldest = head;
+
+    /* Anything but erased flash here means a torn or skipped entry; let fcb_init() sort it out. */
+    uint8_t probe[LOG_STORAGE_META_PROBE_BYTES];
+    size_t probe_len = MIN(sizeof(probe), tail->fs_size - fcb->f_active.fe_elem_off);
+
+    ret = flash_area_read(prv_inst.fa, tail->fs_off + fcb->f_active.fe_elem_off, probe, probe_len);
+    if (ret < 0) {
+        return ret;
+    }
+
+    for (size_t i = 0; i < probe_len; i++) {
+        if (probe[i] != fcb->f_erase_value) {
+            return -ESTALE;
+        }
+    }
+
+    return 0;
+}
+
+/** @brief Journal the head and tail sectors if either moved. Caller holds the storage mutex. */
+static void prv_meta_persist(void)
+{
+    const struct fcb *fcb = &prv_inst.fcb_inst;
+    zmod_log_storage_metadata_t meta = prv_inst.metadata;
+
+    meta.head_sector = (uint16_t)(fcb->f_oldest - prv_inst.sectors);
+    meta.tail_sector = (uint16_t)(fcb->f_active.fe_sector - prv_inst.sectors);
+
+    if ((prv_sector_hdr_read(fcb->f_oldest, meta.head_hdr) < 0) ||
+        (prv_sector_hdr_read(fcb->f_active.fe_sector, meta.tail_hdr) < 0)) {
+        return;
+    }
+
+    if ((prv_inst.metadata.magic == LOG_STORAGE_META_MAGIC) &&
+        (memcmp(&meta.head_sector, &prv_inst.metadata.head_sector,
+                offsetof(zmod_log_storage_metadata_t, crc) -
+                offsetof(zmod_log_storage_metadata_t, head_sector)) == 0)) {
+        return;
+    }
+
+    meta.magic = LOG_STORAGE_META_MAGIC;
+    meta.seq++;
+    meta.crc = prv_meta_crc(&meta);
+
+    if (prv_inst.meta_slot >= (prv_inst.meta_sector->fs_size / sizeof(meta))) {
+        prv_stats_erase(prv_inst.meta_sector);
+        if (flash_area_erase(prv_inst.fa, prv_inst.meta_sector->fs_off, prv_inst.meta_sector->fs_size) < 0) {
+            return;
+        }
+        prv_inst.meta_slot = 0U;
+    }
+
+    int ret = flash_area_write(prv_inst.fa,
+                               prv_inst.meta_sector->fs_off + (prv_inst.meta_slot * sizeof(meta)),
+                               &meta,
+                               sizeof(meta));
+
+    prv_inst.meta_slot++;
+
+    if (ret == 0) {
+        prv_inst.metadata = meta;
+    }
+}
+#else
+static inline void prv_meta_persist(void)
+{
+}
+#endif
+
 int zmod_log_storage_init(void)
 {
     if (prv_inst.fa != NULL) {
@@ -158,13 +886,33 @@ int zmod_log_storage_init(void)
         return -E2BIG;
     }
 
+    if (sector_count < (LOG_STORAGE_RESERVED_SECTORS + 2U)) {
+        LOG_ERR("Partition has %u sectors, need at least %u", sector_count, LOG_STORAGE_RESERVED_SECTORS + 2U);
+        flash_area_close(prv_inst.fa);
+        prv_inst.fa = NULL;
+        return -EINVAL;
+    }
+
     memset(&prv_inst.fcb_inst, 0, sizeof(prv_inst.fcb_inst));
     prv_inst.fcb_inst.f_magic = LOG_STORAGE_FCB_MAGIC;
     prv_inst.fcb_inst.f_sectors = prv_inst.sectors;
-    prv_inst.fcb_inst.f_sector_cnt = (uint8_t)sector_count;
+    prv_inst.fcb_inst.f_sector_cnt = (uint8_t)(sector_count - LOG_STORAGE_RESERVED_SECTORS);
     prv_inst.fcb_inst.f_scratch_cnt = 1U;
+    prv_inst.read_head.fcb = &prv_inst.fcb_inst;
+    memset(&prv_inst.metadata, 0, sizeof(prv_inst.metadata));
 
+    int64_t mount_start = k_uptime_get();
+
+#ifdef CONFIG_ZMOD_LOG_STORAGE_FAST_MOUNT
+    prv_inst.meta_sector = &prv_inst.sectors[sector_count - LOG_STORAGE_META_SECTORS];
+    ret = prv_meta_mount();
+    if (ret < 0) {
+        LOG_INF("Metadata journal unusable (%d), scanning all sectors", ret);
+        ret = fcb_init(LOG_STORAGE_FLASH_AREA_ID, &prv_inst.fcb_inst);
+    }
+#else
     ret = fcb_init(LOG_STORAGE_FLASH_AREA_ID, &prv_inst.fcb_inst);
+#endif
     if (ret < 0) {
         LOG_ERR("Failed to initialize FCB: %d", ret);
         flash_area_close(prv_inst.fa);
@@ -172,28 +920,621 @@ int zmod_log_storage_init(void)
         return ret;
     }
 
+    LOG_DBG("Log storage mounted in %u ms", (uint32_t)(k_uptime_get() - mount_start));
+
+#ifdef CONFIG_ZMOD_LOG_STORAGE_PRIORITY_TIER
+    memset(&prv_inst.priority_fcb, 0, sizeof(prv_inst.priority_fcb));
+    prv_inst.priority_fcb.f_magic = LOG_STORAGE_PRIORITY_FCB_MAGIC;
+    prv_inst.priority_fcb.f_sectors = &prv_inst.sectors[sector_count - LOG_STORAGE_RESERVED_SECTORS];
+    prv_inst.priority_fcb.f_sector_cnt = LOG_STORAGE_PRIORITY_SECTORS;
+    prv_inst.priority_fcb.f_scratch_cnt = 1U;
+
+    ret = fcb_init(LOG_STORAGE_FLASH_AREA_ID, &prv_inst.priority_fcb);
+    if (ret < 0) {
+        LOG_ERR("Failed to initialize priority FCB: %d", ret);
+        flash_area_close(prv_inst.fa);
+        prv_inst.fa = NULL;
+        return ret;
+    }
+#endif
+
     k_mutex_init(&prv_inst.mutex);
+#ifdef CONFIG_ZMOD_LOG_STORAGE_WEAR
+    k_work_init_delayable(&prv_inst.wear_work, prv_wear_work_handler);
+#endif
     zmod_log_storage_reset_read();
     prv_inst.export_in_progress = false;
+    prv_inst.snapshot_active = false;
+    prv_meta_persist();
+
+#ifdef CONFIG_ZMOD_LOG_STORAGE_PANIC_SECTOR
+    /* Panic lines from the last run go in ahead of anything logged during this boot. */
+    prv_inst.panic_sector = &prv_inst.sectors[sector_count - LOG_STORAGE_PANIC_SECTORS - LOG_STORAGE_META_SECTORS];
+    prv_panic_recover();
+#endif
+#ifdef CONFIG_ZMOD_LOG_STORAGE_RETAINED_RAM
+    prv_retained_recover();
+#endif
+
+#ifdef CONFIG_ZMOD_LOG_STORAGE_STAGING
+    prv_inst.pack_capacity = prv_pack_capacity();
+    prv_log_time_init();
+    memset(&prv_inst.pack_hdr, 0, sizeof(prv_inst.pack_hdr));
+    prv_inst.pack_blocked = false;
+    prv_inst.ring_off = 0U;
+#ifdef CONFIG_ZMOD_LOG_STORAGE_COMPRESSION
+    memset(&prv_inst.pack_pending, 0, sizeof(prv_inst.pack_pending));
+    prv_inst.raw_len = 0U;
+    prv_inst.raw_done = 0U;
+    prv_inst.decomp_valid = false;
+    (void)LZ4_initStream(&prv_inst.lz4_stream, sizeof(prv_inst.lz4_stream));
+#endif
+    memset(prv_inst.staging_buf, 0, sizeof(prv_inst.staging_buf));
+    atomic_set(&prv_inst.ring_head, 0);
+    atomic_set(&prv_inst.ring_tail, 0);
+    atomic_set(&prv_inst.ring_dropped_records, 0);
+    atomic_set(&prv_inst.ring_dropped_bytes, 0);
+    atomic_set(&prv_inst.staging_dropped, 0);
+    k_sem_init(&prv_inst.flush_sem, 0, 1);
+
+    k_thread_create(&prv_inst.flush_thread,
+                    prv_flush_thread_stack,
+                    K_THREAD_STACK_SIZEOF(prv_flush_thread_stack),
+                    prv_flush_thread,
+                    NULL,
+                    NULL,
+                    NULL,
+                    LOG_STORAGE_FLUSH_THREAD_PRIORITY,
+                    0,
+                    K_NO_WAIT);
+    k_thread_name_set(&prv_inst.flush_thread, "zmod_log_flush");
+#endif
 
     return 0;
 }
 
-int zmod_log_storage_add_data(const void *buf, size_t buf_size)
+#ifdef CONFIG_ZMOD_LOG_STORAGE_COMPRESSION
+/**
+ * @brief Expand an LZ4 container into decomp_buf.
+ *
+ * Caller holds the storage mutex. The last decoded entry stays cached so a
+ * reader streaming one container in small pieces only decodes it once.
+ */
+static int prv_entry_decompress(const struct fcb_entry *entry, const prv_entry_info_t *info)
 {
-    if (buf == NULL) {
-        return -EINVAL;
-    }
-
-    if (buf_size == 0U) {
+    if (prv_inst.decomp_valid &&
+        (prv_inst.decomp_entry.fe_sector == entry->fe_sector) &&
+        (prv_inst.decomp_entry.fe_elem_off == entry->fe_elem_off)) {
         return 0;
     }
 
-    if (prv_inst.export_in_progress) {
-        return 0;
-    }
+    LZ4_streamDecode_t stream;
+    uint32_t base = FCB_ENTRY_FA_DATA_OFF((*entry));
+    uint32_t pos = info->off;
+    uint32_t end = (uint32_t)info->off + info->stored_len;
+    uint16_t out = 0U;
 
-    int ret = k_mutex_lock(&prv_inst.mutex, K_MSEC(LOG_STORAGE_MUTEX_TIMEOUT_MS));
+    prv_inst.decomp_valid = false;
+    (void)LZ4_setStreamDecode(&stream, NULL, 0);
+
+    while ((pos + LOG_STORAGE_COMPRESS_BLOCK_HDR) <= end) {
+        uint8_t blk_hdr[LOG_STORAGE_COMPRESS_BLOCK_HDR];
+        int ret = flash_area_read(prv_inst.fa, base + pos, blk_hdr, sizeof(blk_hdr));
+
+        if (ret < 0) {
+            return ret;
+        }
+
+        uint16_t raw_len = sys_get_le16(&blk_hdr[0]);
+        uint16_t comp_len = sys_get_le16(&blk_hdr[2]);
+
+        pos += sizeof(blk_hdr);
+        if ((comp_len > sizeof(prv_inst.decomp_scratch)) || ((pos + comp_len) > end)) {
+            return -EIO;
+        }
+
+        ret = flash_area_read(prv_inst.fa, base + pos, prv_inst.decomp_scratch, comp_len);
+        if (ret < 0) {
+            return ret;
+        }
+
+        int n = LZ4_decompress_safe_continue(&stream,
+                                             (const char *)prv_inst.decomp_scratch,
+                                             (char *)&prv_inst.decomp_buf[out],
+                                             comp_len,
+                                             (int)(sizeof(prv_inst.decomp_buf) - out));
+
+        if (n != (int)raw_len) {
+            return -EIO;
+        }
+
+        out += raw_len;
+        pos += comp_len;
+    }
+
+    prv_inst.decomp_entry = *entry;
+    prv_inst.decomp_len = out;
+    prv_inst.decomp_valid = true;
+    return 0;
+}
+#endif
+
+/**
+ * @brief Read the container header of an FCB entry.
+ *
+ * @return 1 if the entry is a valid container, 0 for raw entries, or a
+ *         negative errno on read failure.
+ */
+static int prv_entry_hdr(const struct fcb_entry *entry, prv_log_container_hdr_t *hdr)
+{
+    if (entry->fe_data_len < sizeof(*hdr)) {
+        return 0;
+    }
+
+    int ret = flash_area_read(prv_inst.fa, FCB_ENTRY_FA_DATA_OFF((*entry)), hdr, sizeof(*hdr));
+
+    if (ret < 0) {
+        return ret;
+    }
+
+    return ((hdr->magic == LOG_STORAGE_CONTAINER_MAGIC) &&
+            (hdr->version == LOG_STORAGE_CONTAINER_VERSION) &&
+            (hdr->payload_len <= (entry->fe_data_len - sizeof(*hdr)))) ? 1 : 0;
+}
+
+/**
+ * @brief Locate the log payload inside an FCB entry.
+ *
+ * Packed containers are unwrapped to their payload; anything else is treated
+ * as raw log bytes spanning the whole entry. Compressed containers are decoded
+ * here so @p info->len reports the expanded size.
+ */
+static int prv_entry_payload(const struct fcb_entry *entry, prv_entry_info_t *info)
+{
+    prv_log_container_hdr_t hdr;
+
+    info->off = 0U;
+    info->stored_len = entry->fe_data_len;
+    info->len = entry->fe_data_len;
+    info->flags = 0U;
+
+    int ret = prv_entry_hdr(entry, &hdr);
+
+    if (ret <= 0) {
+        return ret;
+    }
+
+    info->off = sizeof(hdr);
+    info->stored_len = hdr.payload_len;
+    info->len = hdr.payload_len;
+    info->flags = hdr.flags;
+
+    if ((hdr.flags & LOG_STORAGE_CONTAINER_FLAG_LZ4) != 0U) {
+#ifdef CONFIG_ZMOD_LOG_STORAGE_COMPRESSION
+        ret = prv_entry_decompress(entry, info);
+        if (ret < 0) {
+            return ret;
+        }
+        info->len = prv_inst.decomp_len;
+#else
+        /* Written by a build with compression enabled; this image cannot expand it. */
+        info->len = 0U;
+#endif
+    }
+
+    return 0;
+}
+
+/** @brief Copy @p len log bytes starting @p pos bytes into an entry's payload. */
+static int prv_entry_read(const struct fcb_entry *entry,
+                          const prv_entry_info_t *info,
+                          uint32_t pos,
+                          void *dst,
+                          size_t len)
+{
+#ifdef CONFIG_ZMOD_LOG_STORAGE_COMPRESSION
+    if ((info->flags & LOG_STORAGE_CONTAINER_FLAG_LZ4) != 0U) {
+        int ret = prv_entry_decompress(entry, info);
+
+        if (ret < 0) {
+            return ret;
+        }
+
+        memcpy(dst, &prv_inst.decomp_buf[pos], len);
+        return 0;
+    }
+#endif
+
+    return flash_area_read(prv_inst.fa, FCB_ENTRY_FA_DATA_OFF((*entry)) + info->off + pos, dst, len);
+}
+
+#if defined(CONFIG_ZMOD_LOG_STORAGE_STAGING) || defined(CONFIG_ZMOD_LOG_STORAGE_TIME_INDEX)
+/**
+ * @brief Read an entry's container header and the number of log bytes it expands to.
+ *
+ * Compressed sizes come from the LZ4 block headers, so nothing is decompressed.
+ *
+ * @return Same as prv_entry_hdr().
+ */
+static int prv_entry_tally(const struct fcb_entry *entry, prv_log_container_hdr_t *hdr, uint32_t *log_bytes)
+{
+    int ret = prv_entry_hdr(entry, hdr);
+
+    *log_bytes = (ret > 0) ? hdr->payload_len : entry->fe_data_len;
+
+    if ((ret <= 0) || ((hdr->flags & LOG_STORAGE_CONTAINER_FLAG_LZ4) == 0U)) {
+        return ret;
+    }
+
+    *log_bytes = 0U;
+#ifdef CONFIG_ZMOD_LOG_STORAGE_COMPRESSION
+    uint32_t base = FCB_ENTRY_FA_DATA_OFF((*entry));
+    uint32_t pos = sizeof(*hdr);
+    uint32_t end = pos + hdr->payload_len;
+
+    while ((pos + LOG_STORAGE_COMPRESS_BLOCK_HDR) <= end) {
+        uint8_t blk_hdr[LOG_STORAGE_COMPRESS_BLOCK_HDR];
+        int err = flash_area_read(prv_inst.fa, base + pos, blk_hdr, sizeof(blk_hdr));
+
+        if (err < 0) {
+            return err;
+        }
+
+        *log_bytes += sys_get_le16(&blk_hdr[0]);
+        pos += sizeof(blk_hdr) + sys_get_le16(&blk_hdr[2]);
+    }
+#endif
+
+    return ret;
+}
+
+/**
+ * @brief Summarize the entries stored in one FCB sector.
+ *
+ * Caller holds the storage mutex or is initializing the module.
+ */
+static void prv_sector_summarize(struct flash_sector *sector, prv_sector_index_t *idx)
+{
+    struct fcb_entry loc = {.fe_sector = sector, .fe_elem_off = 0U};
+    prv_log_container_hdr_t hdr;
+
+    memset(idx, 0, sizeof(*idx));
+
+    while ((fcb_getnext(&prv_inst.fcb_inst, &loc) == 0) && (loc.fe_sector == sector)) {
+        uint32_t log_bytes = 0U;
+        int ret = prv_entry_tally(&loc, &hdr, &log_bytes);
+
+        if (ret < 0) {
+            continue;
+        }
+        idx->log_bytes += log_bytes;
+
+        if (ret == 0) {
+            idx->record_count++;
+            continue;
+        }
+        if (hdr.record_count == 0U) {
+            continue;
+        }
+
+        if ((idx->container_count == 0U) || (hdr.first_ts_ms < idx->first_ts_ms)) {
+            idx->first_ts_ms = hdr.first_ts_ms;
+        }
+        idx->last_ts_ms = MAX(idx->last_ts_ms, hdr.last_ts_ms);
+        idx->container_count++;
+        idx->record_count += hdr.record_count;
+    }
+}
+
+/** @brief Sector written before @p sector in the ring of @p fcb. */
+static struct flash_sector *prv_sector_prev(const struct fcb *fcb, struct flash_sector *sector)
+{
+    return (sector == &fcb->f_sectors[0]) ? &fcb->f_sectors[fcb->f_sector_cnt - 1U] : (sector - 1);
+}
+#endif
+
+#ifdef CONFIG_ZMOD_LOG_STORAGE_TIME_INDEX
+/** @brief Index every sector in the ring once; later writes keep it current. */
+static void prv_index_build(void)
+{
+    if (prv_inst.index_valid) {
+        return;
+    }
+
+    memset(prv_inst.index, 0, sizeof(prv_inst.index));
+
+    struct flash_sector *sector = prv_inst.fcb_inst.f_oldest;
+
+    while (true) {
+        prv_sector_summarize(sector, &prv_inst.index[sector - prv_inst.sectors]);
+
+        if (sector == prv_inst.fcb_inst.f_active.fe_sector) {
+            break;
+        }
+        sector = fcb_getnext_sector(&prv_inst.fcb_inst, sector);
+    }
+
+    prv_inst.index_valid = true;
+}
+
+/**
+ * @brief Add the @p len byte entry just written to @p sector to the index.
+ *
+ * The packed container is recognized by its buffer; anything else is a raw
+ * entry of one record. Caller holds the mutex.
+ */
+static void prv_index_note(const struct flash_sector *sector, const void *buf, size_t len)
+{
+    if (!prv_inst.index_valid) {
+        return;
+    }
+
+    prv_sector_index_t *idx = &prv_inst.index[sector - prv_inst.sectors];
+
+#ifdef CONFIG_ZMOD_LOG_STORAGE_STAGING
+    if (buf == prv_inst.pack_buf) {
+        const prv_log_container_hdr_t *hdr = &prv_inst.pack_hdr;
+
+        if (idx->container_count == 0U) {
+            idx->first_ts_ms = hdr->first_ts_ms;
+        }
+        idx->last_ts_ms = MAX(idx->last_ts_ms, hdr->last_ts_ms);
+        idx->container_count++;
+        idx->record_count += hdr->record_count;
+#ifdef CONFIG_ZMOD_LOG_STORAGE_COMPRESSION
+        idx->log_bytes += prv_inst.raw_done;
+#else
+        idx->log_bytes += hdr->payload_len;
+#endif
+        return;
+    }
+#endif
+
+    idx->record_count++;
+    idx->log_bytes += len;
+}
+
+/** @brief Forget the summary of a sector that is about to be erased. */
+static void prv_index_drop(const struct flash_sector *sector)
+{
+    memset(&prv_inst.index[sector - prv_inst.sectors], 0, sizeof(prv_sector_index_t));
+}
+
+/**
+ * @brief Point @p loc at the first sector holding data inside @p range.
+ *
+ * @retval -ENOENT No stored container overlaps the range.
+ */
+static int prv_time_seek(const prv_time_range_t *range, struct fcb_entry *loc)
+{
+    prv_index_build();
+
+    struct flash_sector *sector = prv_inst.fcb_inst.f_oldest;
+
+    while (true) {
+        const prv_sector_index_t *idx = &prv_inst.index[sector - prv_inst.sectors];
+
+        if ((idx->container_count > 0U) && (idx->last_ts_ms >= range->since_ms)) {
+            if (idx->first_ts_ms > range->until_ms) {
+                return -ENOENT;
+            }
+
+            loc->fe_sector = sector;
+            loc->fe_elem_off = 0U;
+            return 0;
+        }
+
+        if (sector == prv_inst.fcb_inst.f_active.fe_sector) {
+            return -ENOENT;
+        }
+        sector = fcb_getnext_sector(&prv_inst.fcb_inst, sector);
+    }
+}
+#endif
+
+/**
+ * @brief Apply a time window to the entry at @p loc.
+ *
+ * @retval 0 Entry is inside the window (or no window is set).
+ * @retval -EAGAIN Entry is before the window or has no timestamps; skip it.
+ * @retval -ENOENT Entry is past the window; nothing later can match.
+ */
+static int prv_time_filter(const prv_time_range_t *range, const struct fcb_entry *loc)
+{
+    prv_log_container_hdr_t hdr;
+
+    if (!range->active) {
+        return 0;
+    }
+
+    int ret = prv_entry_hdr(loc, &hdr);
+
+    if (ret < 0) {
+        return ret;
+    }
+
+    if ((ret == 0) || (hdr.last_ts_ms < range->since_ms)) {
+        return -EAGAIN;
+    }
+
+    return (hdr.first_ts_ms > range->until_ms) ? -ENOENT : 0;
+}
+
+/**
+ * @brief Release the sector held by the last in-place span of @p ctx.
+ *
+ * Wakes the flusher in case a container was held back waiting for it.
+ */
+static void prv_span_release(zmod_log_storage_read_ctx_t *ctx)
+{
+    if (ctx->span_sector == NULL) {
+        return;
+    }
+
+    ctx->span_sector = NULL;
+#ifdef CONFIG_ZMOD_LOG_STORAGE_STAGING
+    k_sem_give(&prv_inst.flush_sem);
+#endif
+}
+
+/**
+ * @brief Check whether an in-place span of a cursor of @p fcb points into @p sector.
+ *
+ * A NULL @p sector matches any sector. Caller holds the mutex.
+ */
+static bool prv_span_pinned(const struct fcb *fcb, const struct flash_sector *sector)
+{
+    for (size_t i = 0U; i <= ARRAY_SIZE(prv_inst.cursors); i++) {
+        const zmod_log_storage_read_ctx_t *ctx = (i == 0U) ? &prv_inst.read_head : &prv_inst.cursors[i - 1U];
+
+        if ((ctx->fcb == fcb) && (ctx->span_sector != NULL) &&
+            ((sector == NULL) || (ctx->span_sector == sector))) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/** @brief Move a cursor back before the oldest entry, keeping its window, end marker and slot. */
+static void prv_cursor_rewind(zmod_log_storage_read_ctx_t *ctx)
+{
+    prv_span_release(ctx);
+    memset(&ctx->head, 0, sizeof(ctx->head));
+    memset(&ctx->info, 0, sizeof(ctx->info));
+    ctx->read_bytes = 0U;
+    ctx->skip_bytes = 0U;
+    ctx->at_end = false;
+    ctx->stale = false;
+}
+
+/** @brief Make @p ctx stop at the current append position. Caller holds the mutex. */
+static void prv_cursor_bound(zmod_log_storage_read_ctx_t *ctx)
+{
+    ctx->end = ctx->fcb->f_active;
+    ctx->bounded = true;
+    ctx->at_end = false;
+}
+
+/**
+ * @brief Invalidate read positions inside @p sector before it is erased.
+ *
+ * Affected cursors of @p fcb restart from the oldest entry and pool cursors
+ * report -ESTALE once. A bounded cursor whose end marker is erased has nothing
+ * left to read. A NULL @p sector means the whole FCB was erased. Caller holds
+ * the mutex.
+ */
+static void prv_cursors_invalidate(const struct fcb *fcb, const struct flash_sector *sector)
+{
+    for (size_t i = 0U; i <= ARRAY_SIZE(prv_inst.cursors); i++) {
+        zmod_log_storage_read_ctx_t *ctx = (i == 0U) ? &prv_inst.read_head : &prv_inst.cursors[i - 1U];
+
+        if (((i > 0U) && !ctx->in_use) || (ctx->fcb != fcb)) {
+            continue;
+        }
+
+        bool end_erased = ctx->bounded && ((sector == NULL) || (ctx->end.fe_sector == sector));
+
+        if ((sector == NULL) || (ctx->head.fe_sector == sector)) {
+            prv_cursor_rewind(ctx);
+            ctx->stale = true;
+        }
+
+        if (end_erased) {
+            ctx->at_end = true;
+        }
+    }
+}
+
+/**
+ * @brief Check whether a cursor stepped past its end marker.
+ *
+ * @param prev Sector the cursor was in before advancing to its current entry.
+ */
+static bool prv_cursor_past_end(const zmod_log_storage_read_ctx_t *ctx, const struct flash_sector *prev)
+{
+    if (!ctx->bounded) {
+        return false;
+    }
+
+    if (ctx->head.fe_sector == ctx->end.fe_sector) {
+        return ctx->head.fe_elem_off >= ctx->end.fe_elem_off;
+    }
+
+    /* Sectors after the end sector only hold data appended since the marker was set. */
+    return prev == ctx->end.fe_sector;
+}
+
+/**
+ * @brief Advance a read cursor to the next entry it should return.
+ *
+ * Applies the cursor's end marker and time window. Caller holds the storage
+ * mutex.
+ *
+ * @return 0 on success, -ENOENT when the read is complete, or a negative
+ *         errno from the FCB.
+ */
+static int prv_read_next(zmod_log_storage_read_ctx_t *ctx)
+{
+    int ret;
+
+    if (ctx->at_end) {
+        return -ENOENT;
+    }
+
+    do {
+        const struct flash_sector *prev = ctx->head.fe_sector;
+
+        ret = fcb_getnext(ctx->fcb, &ctx->head);
+
+        /* The FCB reports running off the end of the active sector as -ENOTSUP. */
+        if (ret == -ENOTSUP) {
+            ret = -ENOENT;
+        }
+
+        if ((ret == 0) && prv_cursor_past_end(ctx, prev)) {
+            ctx->at_end = true;
+            ret = -ENOENT;
+        }
+
+        if (ret == 0) {
+            ret = prv_time_filter(&ctx->range, &ctx->head);
+        }
+    } while (ret == -EAGAIN);
+
+    return ret;
+}
+
+/**
+ * @brief Check whether an export snapshot still needs @p sector.
+ *
+ * Only the sector the export reader is in can be pinned: sectors behind it
+ * have been read, and rotation always removes the oldest sector first.
+ */
+static bool prv_snapshot_pinned(const struct flash_sector *sector)
+{
+    const zmod_log_storage_read_ctx_t *ctx = &prv_inst.read_head;
+
+    if (!prv_inst.snapshot_active || ctx->at_end) {
+        return false;
+    }
+
+    const struct flash_sector *reading = (ctx->head.fe_sector != NULL) ? ctx->head.fe_sector
+                                                                        : prv_inst.fcb_inst.f_oldest;
+
+    return reading == sector;
+}
+
+/**
+ * @brief Append one FCB record, rotating out the oldest sector when the ring is full.
+ *
+ * @retval -EAGAIN The oldest sector is pinned by an export snapshot or an
+ *                 in-place span; nothing was written.
+ */
+static int prv_append_record(const void *buf, size_t buf_size)
+{
+    uint32_t start = k_cycle_get_32();
+    int ret = prv_lock();
 
     if (ret < 0) {
         if (!prv_inst.export_in_progress) {
@@ -207,7 +1548,22 @@ int zmod_log_storage_add_data(const void *buf, size_t buf_size)
     ret = fcb_append(&prv_inst.fcb_inst, buf_size, &loc);
 
     if (ret == -ENOSPC) {
+        if (prv_snapshot_pinned(prv_inst.fcb_inst.f_oldest) ||
+            prv_span_pinned(&prv_inst.fcb_inst, prv_inst.fcb_inst.f_oldest)) {
+            k_mutex_unlock(&prv_inst.mutex);
+            return -EAGAIN;
+        }
+
+        prv_cursors_invalidate(&prv_inst.fcb_inst, prv_inst.fcb_inst.f_oldest);
+        prv_stats_erase(prv_inst.fcb_inst.f_oldest);
+        prv_inst.stats.rotations++;
+#ifdef CONFIG_ZMOD_LOG_STORAGE_TIME_INDEX
+        prv_index_drop(prv_inst.fcb_inst.f_oldest);
+#endif
         ret = fcb_rotate(&prv_inst.fcb_inst);
+#ifdef CONFIG_ZMOD_LOG_STORAGE_COMPRESSION
+        prv_inst.decomp_valid = false;
+#endif
 
         if (ret < 0) {
             if (!prv_inst.export_in_progress) {
@@ -225,8 +1581,21 @@ int zmod_log_storage_add_data(const void *buf, size_t buf_size)
         if (!prv_inst.export_in_progress) {
             LOG_ERR("Failed to get location to write to: %d", ret);
         }
+        if (prv_span_pinned(&prv_inst.fcb_inst, NULL)) {
+            /* Not erased under a reader's span; a later append tries again. */
+            k_mutex_unlock(&prv_inst.mutex);
+            return ret;
+        }
         (void)fcb_clear(&prv_inst.fcb_inst);
-        memset(&prv_inst.read_head, 0, sizeof(prv_inst.read_head));
+        prv_stats_clear(&prv_inst.fcb_inst);
+        prv_cursors_invalidate(&prv_inst.fcb_inst, NULL);
+#ifdef CONFIG_ZMOD_LOG_STORAGE_COMPRESSION
+        prv_inst.decomp_valid = false;
+#endif
+#ifdef CONFIG_ZMOD_LOG_STORAGE_TIME_INDEX
+        prv_inst.index_valid = false;
+#endif
+        prv_meta_persist();
         k_mutex_unlock(&prv_inst.mutex);
         return ret;
     }
@@ -246,254 +1615,2457 @@ int zmod_log_storage_add_data(const void *buf, size_t buf_size)
         if (!prv_inst.export_in_progress) {
             LOG_ERR("Failed to finalize write: %d", ret);
         }
-        k_mutex_unlock(&prv_inst.mutex);
-        return ret;
+        k_mutex_unlock(&prv_inst.mutex);
+        return ret;
+    }
+
+    uint32_t cycles = k_cycle_get_32() - start;
+
+#ifdef CONFIG_ZMOD_LOG_STORAGE_TIME_INDEX
+    prv_index_note(loc.fe_sector, buf, buf_size);
+#endif
+    prv_stats_append(buf_size);
+    prv_inst.stats.append_cycles_max = MAX(prv_inst.stats.append_cycles_max, cycles);
+    prv_inst.stats.append_cycles_total += cycles;
+    prv_inst.stats.append_count++;
+
+    prv_meta_persist();
+    k_mutex_unlock(&prv_inst.mutex);
+    return 0;
+}
+
+#ifdef CONFIG_ZMOD_LOG_STORAGE_PANIC_SECTOR
+/** @brief Program panic_buf padded to the flash write block. */
+static int prv_panic_flush_buf(void)
+{
+    size_t len = ROUND_UP(prv_inst.panic_fill, MAX(flash_area_align(prv_inst.fa), 1U));
+
+    if (len == 0U) {
+        return 0;
+    }
+
+    memset(&prv_inst.panic_buf[prv_inst.panic_fill], flash_area_erased_val(prv_inst.fa), len - prv_inst.panic_fill);
+
+    int ret = flash_area_write(prv_inst.fa, prv_inst.panic_sector->fs_off + prv_inst.panic_off, prv_inst.panic_buf, len);
+
+    prv_inst.panic_off += len;
+    prv_inst.panic_fill = 0U;
+    return ret;
+}
+
+/** @brief Queue bytes for the panic sector, programming every full write buffer. */
+static void prv_panic_put(const uint8_t *src, size_t len)
+{
+    while (len > 0U) {
+        size_t n = MIN(len, sizeof(prv_inst.panic_buf) - prv_inst.panic_fill);
+
+        memcpy(&prv_inst.panic_buf[prv_inst.panic_fill], src, n);
+        prv_inst.panic_fill += n;
+        src += n;
+        len -= n;
+
+        if (prv_inst.panic_fill == sizeof(prv_inst.panic_buf)) {
+            (void)prv_panic_flush_buf();
+        }
+    }
+}
+
+/**
+ * @brief Append one record to the panic sector.
+ *
+ * Safe in fault context: no mutex, no erase, only direct flash writes into
+ * space erased at boot. The sector starts with LOG_STORAGE_PANIC_MAGIC; each
+ * record is a little-endian u16 length and the data, padded to the flash
+ * write block.
+ *
+ * @retval -ENOSPC The record does not fit; it was counted as dropped.
+ */
+static int prv_panic_write(const void *buf, size_t len)
+{
+    if (len == 0U) {
+        return 0;
+    }
+
+    size_t align = MAX(flash_area_align(prv_inst.fa), 1U);
+    size_t need = ROUND_UP(sizeof(uint16_t) + len, align);
+
+    if (prv_inst.panic_off == 0U) {
+        need += ROUND_UP(LOG_STORAGE_PANIC_MAGIC_BYTES, align);
+    }
+
+    if ((len >= UINT16_MAX) || ((prv_inst.panic_off + need) > prv_inst.panic_sector->fs_size)) {
+        atomic_add(&prv_inst.panic_dropped, (atomic_val_t)len);
+        return -ENOSPC;
+    }
+
+    uint8_t hdr[MAX(LOG_STORAGE_PANIC_MAGIC_BYTES, sizeof(uint16_t))];
+
+    if (prv_inst.panic_off == 0U) {
+        sys_put_le32(LOG_STORAGE_PANIC_MAGIC, hdr);
+        prv_panic_put(hdr, LOG_STORAGE_PANIC_MAGIC_BYTES);
+        (void)prv_panic_flush_buf();
+    }
+
+    sys_put_le16((uint16_t)len, hdr);
+    prv_panic_put(hdr, sizeof(uint16_t));
+    prv_panic_put(buf, len);
+
+    return prv_panic_flush_buf();
+}
+
+/**
+ * @brief Move records left by the panic writer into the FCB and re-erase the sector.
+ *
+ * Records are appended as raw entries, which readers return as plain log
+ * bytes. A sector without the magic that is not erased (e.g. former FCB data)
+ * is simply erased. If a read or append fails part way, the sector is kept
+ * and merged again at the next boot, repeating the records already moved
+ * rather than losing the rest; the panic writer is disabled until then.
+ */
+static void prv_panic_recover(void)
+{
+    const struct flash_sector *sector = prv_inst.panic_sector;
+    uint8_t erased = flash_area_erased_val(prv_inst.fa);
+    size_t align = MAX(flash_area_align(prv_inst.fa), 1U);
+    uint8_t buf[LOG_STORAGE_PANIC_BUF_SIZE];
+    uint32_t merged = 0U;
+    bool complete = true;
+
+    prv_inst.panic = false;
+    prv_inst.panic_off = 0U;
+    prv_inst.panic_fill = 0U;
+    atomic_set(&prv_inst.panic_dropped, 0);
+
+    if ((align > sizeof(prv_inst.panic_buf)) || ((sizeof(prv_inst.panic_buf) % align) != 0U)) {
+        LOG_WRN("Flash write block of %zu bytes not supported by the panic writer", align);
+        prv_inst.panic_sector = NULL;
+        return;
+    }
+
+    if (flash_area_read(prv_inst.fa, sector->fs_off, buf, LOG_STORAGE_PANIC_MAGIC_BYTES) < 0) {
+        prv_inst.panic_sector = NULL;
+        return;
+    }
+
+    bool has_magic = (sys_get_le32(buf) == LOG_STORAGE_PANIC_MAGIC);
+    bool is_erased = true;
+
+    for (size_t i = 0U; i < LOG_STORAGE_PANIC_MAGIC_BYTES; i++) {
+        is_erased = is_erased && (buf[i] == erased);
+    }
+
+    uint32_t off = ROUND_UP(LOG_STORAGE_PANIC_MAGIC_BYTES, align);
+
+    while (complete && has_magic && ((off + sizeof(uint16_t)) <= sector->fs_size)) {
+        if (flash_area_read(prv_inst.fa, sector->fs_off + off, buf, sizeof(uint16_t)) < 0) {
+            complete = false;
+            break;
+        }
+
+        uint16_t len = sys_get_le16(buf);
+
+        if ((len == 0U) || (len == (uint16_t)((erased << 8) | erased)) ||
+            ((off + sizeof(uint16_t) + len) > sector->fs_size)) {
+            break;
+        }
+
+        for (uint16_t pos = 0U; pos < len; pos += sizeof(buf)) {
+            uint16_t n = MIN((uint16_t)sizeof(buf), len - pos);
+
+            if ((flash_area_read(prv_inst.fa, sector->fs_off + off + sizeof(uint16_t) + pos, buf, n) < 0) ||
+                (prv_append_record(buf, n) < 0)) {
+                complete = false;
+                break;
+            }
+        }
+
+        if (complete) {
+            merged += len;
+            off += ROUND_UP(sizeof(uint16_t) + len, align);
+        }
+    }
+
+    if (!complete) {
+        LOG_ERR("Panic log merge stopped after %u bytes; sector kept for the next boot", merged);
+        prv_inst.panic_sector = NULL;
+        return;
+    }
+
+    if (merged > 0U) {
+        LOG_WRN("Recovered %u bytes of panic logs", merged);
+    }
+
+    if (!is_erased) {
+        prv_stats_erase(sector);
+        if (flash_area_erase(prv_inst.fa, sector->fs_off, sector->fs_size) < 0) {
+            LOG_ERR("Failed to erase panic sector");
+            prv_inst.panic_sector = NULL;
+        }
+    }
+}
+#endif /* CONFIG_ZMOD_LOG_STORAGE_PANIC_SECTOR */
+
+#ifdef CONFIG_ZMOD_LOG_STORAGE_STAGING
+
+/** @brief Current log clock: uptime continued from the newest stored container. */
+static uint32_t prv_log_time_ms(void)
+{
+    return prv_inst.time_base_ms + k_uptime_get_32();
+}
+
+/**
+ * @brief Start the log clock after the newest container already in flash.
+ *
+ * Only the active sector is read, or the one before it when the active
+ * sector has no containers yet.
+ */
+static void prv_log_time_init(void)
+{
+    struct fcb *fcb = &prv_inst.fcb_inst;
+    struct flash_sector *active = fcb->f_active.fe_sector;
+    prv_sector_index_t idx;
+
+    prv_sector_summarize(active, &idx);
+
+    if ((idx.container_count == 0U) && (active != fcb->f_oldest)) {
+        prv_sector_summarize(prv_sector_prev(fcb, active), &idx);
+    }
+
+    uint32_t now = k_uptime_get_32();
+
+    prv_inst.time_base_ms = ((idx.container_count > 0U) && (idx.last_ts_ms >= now)) ? (idx.last_ts_ms + 1U - now) : 0U;
+}
+
+#ifdef CONFIG_ZMOD_LOG_STORAGE_RETAINED_RAM
+/** @brief CRC protecting the fixed fields of the retained ring. */
+static uint32_t prv_retained_crc(void)
+{
+    uint32_t fixed[2] = {prv_retained.magic, prv_retained.size};
+
+    return crc32_ieee((const uint8_t *)fixed, sizeof(fixed));
+}
+
+/**
+ * @brief Copy staged bytes into the retained ring.
+ *
+ * Lock-free like the staging ring: each producer claims its span with one
+ * atomic add and copies into it. Only the newest LOG_STORAGE_RETAINED_SIZE
+ * bytes are kept.
+ */
+static void prv_retained_put(const uint8_t *src, size_t len)
+{
+    uint32_t pos = (uint32_t)atomic_add(&prv_retained.head, (atomic_val_t)len);
+
+    if (len > LOG_STORAGE_RETAINED_SIZE) {
+        src += len - LOG_STORAGE_RETAINED_SIZE;
+        pos += len - LOG_STORAGE_RETAINED_SIZE;
+        len = LOG_STORAGE_RETAINED_SIZE;
+    }
+
+    size_t off = pos & (LOG_STORAGE_RETAINED_SIZE - 1U);
+    size_t first = MIN(len, LOG_STORAGE_RETAINED_SIZE - off);
+
+    memcpy(&prv_retained.data[off], src, first);
+    memcpy(prv_retained.data, &src[first], len - first);
+}
+
+/** @brief Record that @p len more staged bytes reached flash or were dropped. */
+static void prv_retained_flushed(size_t len)
+{
+    atomic_add(&prv_retained.flushed, (atomic_val_t)len);
+}
+
+/**
+ * @brief Append bytes still in the staging path at the last reset to the FCB.
+ *
+ * Runs from init before the flusher starts. A ring with a bad magic, size or
+ * CRC (cold boot, or a build with a different size) is discarded. The ring is
+ * reset afterwards.
+ */
+static void prv_retained_recover(void)
+{
+    uint8_t buf[64];
+    uint32_t head = (uint32_t)atomic_get(&prv_retained.head);
+    uint32_t pending = head - (uint32_t)atomic_get(&prv_retained.flushed);
+    bool valid = (prv_retained.magic == LOG_STORAGE_RETAINED_MAGIC) &&
+                 (prv_retained.size == LOG_STORAGE_RETAINED_SIZE) &&
+                 (prv_retained.crc == prv_retained_crc());
+
+    if (valid && (pending > 0U)) {
+        pending = MIN(pending, LOG_STORAGE_RETAINED_SIZE);
+
+        for (uint32_t pos = head - pending; pos != head;) {
+            size_t off = pos & (LOG_STORAGE_RETAINED_SIZE - 1U);
+            size_t n = MIN(MIN(sizeof(buf), head - pos), LOG_STORAGE_RETAINED_SIZE - off);
+
+            memcpy(buf, &prv_retained.data[off], n);
+            if (prv_append_record(buf, n) < 0) {
+                break;
+            }
+            pos += n;
+        }
+
+        LOG_WRN("Recovered %u bytes of logs from retained RAM", pending);
+    }
+
+    prv_retained.magic = LOG_STORAGE_RETAINED_MAGIC;
+    prv_retained.size = LOG_STORAGE_RETAINED_SIZE;
+    prv_retained.crc = prv_retained_crc();
+    atomic_set(&prv_retained.head, 0);
+    atomic_set(&prv_retained.flushed, 0);
+}
+#endif /* CONFIG_ZMOD_LOG_STORAGE_RETAINED_RAM */
+
+/** @brief Header word of the ring record at position @p pos. */
+static inline atomic_t *prv_ring_hdr(atomic_val_t pos)
+{
+    return (atomic_t *)&prv_inst.staging_buf[(size_t)pos & LOG_STORAGE_RING_MASK];
+}
+
+/**
+ * @brief Reserve space for one record in the staging ring.
+ *
+ * Lock-free and safe from any context: producers race on the head with a
+ * compare-and-swap and never wait for each other or for the flusher. A record
+ * that would straddle the end of the ring is preceded by a committed padding
+ * record so every reservation is contiguous.
+ *
+ * @param flags LOG_STORAGE_RING_PRIORITY or 0.
+ *
+ * @return Pointer to @p len bytes to fill, or NULL if the ring is full.
+ */
+static uint8_t *prv_ring_reserve(size_t len, atomic_val_t flags)
+{
+    size_t total = ROUND_UP(LOG_STORAGE_RING_HDR + len, LOG_STORAGE_RING_HDR);
+    atomic_val_t head;
+    size_t pad;
+
+    do {
+        head = atomic_get(&prv_inst.ring_head);
+        size_t used = (size_t)(head - atomic_get(&prv_inst.ring_tail));
+        size_t off = (size_t)head & LOG_STORAGE_RING_MASK;
+
+        pad = ((off + total) > LOG_STORAGE_STAGING_RING_SIZE) ? (LOG_STORAGE_STAGING_RING_SIZE - off) : 0U;
+
+        if ((used + pad + total) > LOG_STORAGE_STAGING_RING_SIZE) {
+            atomic_inc(&prv_inst.ring_dropped_records);
+            atomic_add(&prv_inst.ring_dropped_bytes, (atomic_val_t)len);
+            if (prv_inst.snapshot_active) {
+                atomic_inc(&prv_inst.stats.export_dropped);
+            }
+            return NULL;
+        }
+    } while (!atomic_cas(&prv_inst.ring_head, head, head + (atomic_val_t)(pad + total)));
+
+    if (pad > 0U) {
+        atomic_set(prv_ring_hdr(head), LOG_STORAGE_RING_PAD | LOG_STORAGE_RING_COMMITTED);
+        head += (atomic_val_t)pad;
+    }
+
+    /* Space handed out is zeroed by the flusher, so the record reads as uncommitted until now. */
+    atomic_set(prv_ring_hdr(head), (atomic_val_t)len | flags);
+
+    return (uint8_t *)prv_ring_hdr(head) + LOG_STORAGE_RING_HDR;
+}
+
+/** @brief Publish a record filled after prv_ring_reserve() to the flusher. */
+static void prv_ring_commit(uint8_t *data)
+{
+    atomic_t *hdr = (atomic_t *)(data - LOG_STORAGE_RING_HDR);
+
+#ifdef CONFIG_ZMOD_LOG_STORAGE_RETAINED_RAM
+    /* Priority records repeat lines already staged for the main tier. */
+    if ((atomic_get(hdr) & LOG_STORAGE_RING_PRIORITY) == 0) {
+        prv_retained_put(data, (size_t)atomic_get(hdr) & LOG_STORAGE_RING_LEN_MASK);
+    }
+#endif
+    (void)atomic_or(hdr, LOG_STORAGE_RING_COMMITTED);
+
+    size_t used = (size_t)(atomic_get(&prv_inst.ring_head) - atomic_get(&prv_inst.ring_tail));
+
+    if (used >= LOG_STORAGE_FLUSH_WATERMARK) {
+        k_sem_give(&prv_inst.flush_sem);
+    }
+}
+
+/**
+ * @brief Oldest committed record in the ring. Flusher only.
+ *
+ * Records are consumed in reservation order, so a reserved but uncommitted
+ * record holds back everything behind it.
+ *
+ * @param len Set to the record data length.
+ * @param priority Set when the record belongs to the priority tier.
+ *
+ * @return Record data, or NULL if the oldest record is not committed yet.
+ */
+static const uint8_t *prv_ring_peek(size_t *len, bool *priority)
+{
+    while (true) {
+        atomic_val_t tail = atomic_get(&prv_inst.ring_tail);
+
+        if (tail == atomic_get(&prv_inst.ring_head)) {
+            return NULL;
+        }
+
+        atomic_val_t hdr = atomic_get(prv_ring_hdr(tail));
+
+        if ((hdr & LOG_STORAGE_RING_COMMITTED) == 0) {
+            return NULL;
+        }
+
+        if ((hdr & LOG_STORAGE_RING_PAD) == 0) {
+            *len = (size_t)hdr & LOG_STORAGE_RING_LEN_MASK;
+            *priority = (hdr & LOG_STORAGE_RING_PRIORITY) != 0;
+            return (const uint8_t *)prv_ring_hdr(tail) + LOG_STORAGE_RING_HDR;
+        }
+
+        size_t pad = LOG_STORAGE_STAGING_RING_SIZE - ((size_t)tail & LOG_STORAGE_RING_MASK);
+
+        memset(prv_ring_hdr(tail), 0, pad);
+        atomic_set(&prv_inst.ring_tail, tail + (atomic_val_t)pad);
+    }
+}
+
+/** @brief Return the record from prv_ring_peek() to the producers. Flusher only. */
+static void prv_ring_release(size_t len)
+{
+    atomic_val_t tail = atomic_get(&prv_inst.ring_tail);
+    size_t total = ROUND_UP(LOG_STORAGE_RING_HDR + len, LOG_STORAGE_RING_HDR);
+
+    memset(prv_ring_hdr(tail), 0, total);
+    atomic_set(&prv_inst.ring_tail, tail + (atomic_val_t)total);
+}
+
+/**
+ * @brief Largest container payload that tiles an FCB sector without waste.
+ *
+ * Each FCB entry costs a length field, the data and a CRC byte, each padded
+ * to the flash write-block size. The configured pack size is shrunk so a whole
+ * number of containers fills the usable part of a sector exactly.
+ */
+static uint16_t prv_pack_capacity(void)
+{
+    uint32_t align = MAX(flash_area_align(prv_inst.fa), 1U);
+    uint32_t usable = LOG_STORAGE_SECTOR_SIZE_BYTES - ROUND_UP(LOG_STORAGE_FCB_SECTOR_HDR_BYTES, align);
+    uint32_t overhead = ROUND_UP(LOG_STORAGE_FCB_LEN_BYTES, align) + ROUND_UP(LOG_STORAGE_FCB_CRC_BYTES, align);
+    uint32_t per_sector = DIV_ROUND_UP(usable, LOG_STORAGE_PACK_SIZE + overhead);
+    uint32_t entry = ROUND_DOWN(usable / per_sector, align) - overhead;
+
+    return (uint16_t)(MIN(entry, LOG_STORAGE_PACK_SIZE) - sizeof(prv_log_container_hdr_t));
+}
+
+/**
+ * @brief Write the open container as one FCB record and start a new one.
+ *
+ * Caller holds the storage mutex. On a write failure the container contents
+ * are counted as dropped. A container refused because an export snapshot pins
+ * the oldest sector stays in RAM and is retried by the next call.
+ */
+static int prv_pack_write(void)
+{
+    prv_log_container_hdr_t *hdr = &prv_inst.pack_hdr;
+
+    if (hdr->record_count == 0U) {
+        return 0;
+    }
+
+    hdr->magic = LOG_STORAGE_CONTAINER_MAGIC;
+    hdr->version = LOG_STORAGE_CONTAINER_VERSION;
+    hdr->flags = IS_ENABLED(CONFIG_ZMOD_LOG_STORAGE_FORMAT_DICTIONARY) ? LOG_STORAGE_CONTAINER_FLAG_DICT : 0U;
+#ifdef CONFIG_ZMOD_LOG_STORAGE_COMPRESSION
+    hdr->flags |= LOG_STORAGE_CONTAINER_FLAG_LZ4;
+#endif
+    memcpy(prv_inst.pack_buf, hdr, sizeof(*hdr));
+
+    int ret = prv_append_record(prv_inst.pack_buf, sizeof(*hdr) + hdr->payload_len);
+
+    prv_inst.pack_blocked = (ret == -EAGAIN);
+    if (prv_inst.pack_blocked) {
+        return ret;
+    }
+
+#ifdef CONFIG_ZMOD_LOG_STORAGE_RETAINED_RAM
+#ifdef CONFIG_ZMOD_LOG_STORAGE_COMPRESSION
+    prv_retained_flushed(prv_inst.raw_done);
+#else
+    prv_retained_flushed(hdr->payload_len);
+#endif
+#endif
+
+    if (ret < 0) {
+        atomic_add(&prv_inst.staging_dropped, (atomic_val_t)hdr->payload_len);
+    }
+
+    memset(hdr, 0, sizeof(*hdr));
+
+#ifdef CONFIG_ZMOD_LOG_STORAGE_COMPRESSION
+    /* Keep the uncompressed tail for the next container, which starts a fresh stream. */
+    uint16_t tail = prv_inst.raw_len - prv_inst.raw_done;
+
+    memmove(prv_inst.pack_raw, &prv_inst.pack_raw[prv_inst.raw_done], tail);
+    prv_inst.raw_len = tail;
+    prv_inst.raw_done = 0U;
+    (void)LZ4_initStream(&prv_inst.lz4_stream, sizeof(prv_inst.lz4_stream));
+#endif
+
+    return ret;
+}
+
+#ifdef CONFIG_ZMOD_LOG_STORAGE_COMPRESSION
+/**
+ * @brief Compress the pending raw bytes as one block of the open container.
+ *
+ * @return 0 on success, -ENOSPC if the block does not fit in the container.
+ */
+static int prv_pack_compress_pending(void)
+{
+    prv_log_container_hdr_t *hdr = &prv_inst.pack_hdr;
+    prv_log_container_hdr_t *pending = &prv_inst.pack_pending;
+    uint16_t raw_len = prv_inst.raw_len - prv_inst.raw_done;
+
+    if (raw_len == 0U) {
+        return 0;
+    }
+
+    int space = (int)prv_inst.pack_capacity - hdr->payload_len - LOG_STORAGE_COMPRESS_BLOCK_HDR;
+
+    if (space <= 0) {
+        return -ENOSPC;
+    }
+
+    uint8_t *blk = &prv_inst.pack_buf[sizeof(*hdr) + hdr->payload_len];
+    int comp_len = LZ4_compress_fast_continue(&prv_inst.lz4_stream,
+                                              (const char *)&prv_inst.pack_raw[prv_inst.raw_done],
+                                              (char *)&blk[LOG_STORAGE_COMPRESS_BLOCK_HDR],
+                                              raw_len,
+                                              space,
+                                              1);
+
+    if (comp_len <= 0) {
+        return -ENOSPC;
+    }
+
+    sys_put_le16(raw_len, &blk[0]);
+    sys_put_le16((uint16_t)comp_len, &blk[2]);
+    hdr->payload_len += LOG_STORAGE_COMPRESS_BLOCK_HDR + comp_len;
+    prv_inst.raw_done += raw_len;
+    prv_inst.raw_total += raw_len;
+    prv_inst.compressed_total += LOG_STORAGE_COMPRESS_BLOCK_HDR + comp_len;
+
+    if (hdr->record_count == 0U) {
+        hdr->first_ts_ms = pending->first_ts_ms;
+    }
+    hdr->record_count += pending->record_count;
+    hdr->last_ts_ms = pending->last_ts_ms;
+    memset(pending, 0, sizeof(*pending));
+
+    return 0;
+}
+
+/** @brief Compress pending bytes, rolling over to a new container when they do not fit. */
+static void prv_pack_compress(void)
+{
+    /* A held-back container is complete; nothing may be added until it is written. */
+    if (prv_inst.pack_blocked && (prv_pack_write() == -EAGAIN)) {
+        return;
+    }
+
+    if (prv_pack_compress_pending() != -ENOSPC) {
+        return;
+    }
+
+    /* A failed LZ4 call leaves the stream unusable; prv_pack_write() resets it. */
+    if (prv_inst.pack_hdr.record_count > 0U) {
+        if (prv_pack_write() == -EAGAIN) {
+            return;
+        }
+
+        if (prv_pack_compress_pending() != -ENOSPC) {
+            return;
+        }
+    }
+
+    /* Does not fit even an empty container: incompressible and too large. */
+    atomic_add(&prv_inst.staging_dropped, (atomic_val_t)(prv_inst.raw_len - prv_inst.raw_done));
+#ifdef CONFIG_ZMOD_LOG_STORAGE_RETAINED_RAM
+    prv_retained_flushed(prv_inst.raw_len - prv_inst.raw_done);
+#endif
+    prv_inst.raw_len = prv_inst.raw_done;
+    memset(&prv_inst.pack_pending, 0, sizeof(prv_inst.pack_pending));
+    (void)LZ4_initStream(&prv_inst.lz4_stream, sizeof(prv_inst.lz4_stream));
+}
+#endif
+
+/** @brief Write out the open container including any data not yet packed into it. */
+static int prv_pack_finalize(void)
+{
+#ifdef CONFIG_ZMOD_LOG_STORAGE_COMPRESSION
+    prv_pack_compress();
+#endif
+    return prv_pack_write();
+}
+
+/** @brief Check whether a staged chunk still fits in the open container. */
+static bool prv_pack_has_room(uint16_t chunk)
+{
+#ifdef CONFIG_ZMOD_LOG_STORAGE_COMPRESSION
+    return (prv_inst.raw_len + chunk) <= sizeof(prv_inst.pack_raw);
+#else
+    return (prv_inst.pack_hdr.payload_len + chunk) <= prv_inst.pack_capacity;
+#endif
+}
+
+/** @brief Account for a chunk copied into the open container. */
+static void prv_pack_chunk_added(uint16_t chunk, uint32_t now)
+{
+#ifdef CONFIG_ZMOD_LOG_STORAGE_COMPRESSION
+    prv_log_container_hdr_t *stats = &prv_inst.pack_pending;
+
+    prv_inst.raw_len += chunk;
+#else
+    prv_log_container_hdr_t *stats = &prv_inst.pack_hdr;
+
+    stats->payload_len += chunk;
+#endif
+
+    if (stats->record_count == 0U) {
+        stats->first_ts_ms = now;
+    }
+    stats->record_count++;
+    stats->last_ts_ms = now;
+
+#ifdef CONFIG_ZMOD_LOG_STORAGE_COMPRESSION
+    if ((prv_inst.raw_len - prv_inst.raw_done) >= LOG_STORAGE_COMPRESS_BLOCK) {
+        prv_pack_compress();
+    }
+#endif
+}
+
+#ifdef CONFIG_ZMOD_LOG_STORAGE_PRIORITY_TIER
+/**
+ * @brief Write one priority record to the priority tier.
+ *
+ * Caller holds the mutex. Each piece of up to LOG_STORAGE_PRIORITY_CHUNK bytes
+ * becomes its own single-chunk container so the tier carries timestamps. The
+ * tier rotates independently of the main FCB and is never pinned by an
+ * export snapshot, only by an in-place span. Failures are counted as write
+ * drops.
+ */
+static void prv_priority_append(const uint8_t *rec, size_t len)
+{
+    struct fcb *fcb = &prv_inst.priority_fcb;
+    prv_log_container_hdr_t hdr = {
+        .magic = LOG_STORAGE_CONTAINER_MAGIC,
+        .version = LOG_STORAGE_CONTAINER_VERSION,
+        .record_count = 1U,
+        .flags = IS_ENABLED(CONFIG_ZMOD_LOG_STORAGE_FORMAT_DICTIONARY) ? LOG_STORAGE_CONTAINER_FLAG_DICT : 0U,
+    };
+
+    hdr.first_ts_ms = prv_log_time_ms();
+    hdr.last_ts_ms = hdr.first_ts_ms;
+
+    for (size_t off = 0U; off < len; off += hdr.payload_len) {
+        hdr.payload_len = (uint16_t)MIN(len - off, LOG_STORAGE_PRIORITY_CHUNK);
+        memcpy(prv_inst.priority_buf, &hdr, sizeof(hdr));
+        memcpy(&prv_inst.priority_buf[sizeof(hdr)], &rec[off], hdr.payload_len);
+
+        size_t entry_len = sizeof(hdr) + hdr.payload_len;
+        struct fcb_entry loc = {0};
+        int ret = fcb_append(fcb, entry_len, &loc);
+
+        if ((ret == -ENOSPC) && prv_span_pinned(fcb, fcb->f_oldest)) {
+            ret = -EAGAIN;
+        } else if (ret == -ENOSPC) {
+            prv_cursors_invalidate(fcb, fcb->f_oldest);
+            prv_stats_erase(fcb->f_oldest);
+            prv_inst.stats.rotations++;
+            ret = fcb_rotate(fcb);
+            if (ret == 0) {
+                ret = fcb_append(fcb, entry_len, &loc);
+            }
+        }
+
+        if (ret == 0) {
+            ret = flash_area_write(prv_inst.fa, FCB_ENTRY_FA_DATA_OFF(loc), prv_inst.priority_buf, entry_len);
+        }
+        if (ret == 0) {
+            ret = fcb_append_finish(fcb, &loc);
+        }
+        if (ret == 0) {
+            prv_stats_append(entry_len);
+        }
+
+        if (ret < 0) {
+            if (!prv_inst.export_in_progress) {
+                LOG_ERR("Failed to write priority record: %d", ret);
+            }
+            atomic_add(&prv_inst.staging_dropped, (atomic_val_t)(len - off));
+            return;
+        }
+    }
+}
+#endif /* CONFIG_ZMOD_LOG_STORAGE_PRIORITY_TIER */
+
+/**
+ * @brief Move every committed ring record into containers, writing full ones.
+ *
+ * Caller holds the mutex. Records are split into chunks of at most
+ * LOG_STORAGE_STAGING_MAX_CHUNK bytes so containers fill evenly. While a full
+ * container is held back by an export snapshot the remaining records stay
+ * queued in the ring.
+ */
+static void prv_staging_drain(void)
+{
+    const uint8_t *rec;
+    size_t len;
+    bool priority;
+
+    while ((rec = prv_ring_peek(&len, &priority)) != NULL) {
+#ifdef CONFIG_ZMOD_LOG_STORAGE_PRIORITY_TIER
+        if (priority) {
+            prv_priority_append(rec, len);
+            prv_ring_release(len);
+            continue;
+        }
+#endif
+        while (prv_inst.ring_off < len) {
+            uint16_t chunk = (uint16_t)MIN(len - prv_inst.ring_off, LOG_STORAGE_STAGING_MAX_CHUNK);
+
+            if (!prv_pack_has_room(chunk)) {
+                (void)prv_pack_finalize();
+
+                if (prv_inst.pack_blocked) {
+                    return;
+                }
+            }
+
+#ifdef CONFIG_ZMOD_LOG_STORAGE_COMPRESSION
+            uint8_t *dst = &prv_inst.pack_raw[prv_inst.raw_len];
+#else
+            uint8_t *dst = &prv_inst.pack_buf[sizeof(prv_log_container_hdr_t) + prv_inst.pack_hdr.payload_len];
+#endif
+            memcpy(dst, &rec[prv_inst.ring_off], chunk);
+            prv_inst.ring_off += chunk;
+            prv_pack_chunk_added(chunk, prv_log_time_ms());
+        }
+
+        prv_inst.ring_off = 0U;
+        prv_ring_release(len);
+    }
+}
+
+/**
+ * @brief Pack staged data and write containers that are full, expired, or forced.
+ *
+ * @param force Write the open container even if it is neither full nor expired.
+ */
+static int prv_staging_flush(bool force)
+{
+    int ret = prv_lock();
+
+    if (ret < 0) {
+        return -EBUSY;
+    }
+
+    prv_staging_drain();
+
+    const prv_log_container_hdr_t *hdr = &prv_inst.pack_hdr;
+#ifdef CONFIG_ZMOD_LOG_STORAGE_COMPRESSION
+    if (hdr->record_count == 0U) {
+        hdr = &prv_inst.pack_pending;
+    }
+#endif
+    bool expired = (hdr->record_count > 0U) &&
+                   ((prv_log_time_ms() - hdr->first_ts_ms) >= LOG_STORAGE_PACK_MAX_AGE_MS);
+
+    if (force || expired) {
+        ret = prv_pack_finalize();
+    }
+
+    k_mutex_unlock(&prv_inst.mutex);
+    return ret;
+}
+
+/** @brief Flusher thread: packs on watermark or latency timeout, writes full/expired containers. */
+static void prv_flush_thread(void *p1, void *p2, void *p3)
+{
+    ARG_UNUSED(p1);
+    ARG_UNUSED(p2);
+    ARG_UNUSED(p3);
+
+    while (1) {
+        (void)k_sem_take(&prv_inst.flush_sem, K_MSEC(LOG_STORAGE_FLUSH_MAX_LATENCY_MS));
+        (void)prv_staging_flush(false);
+    }
+}
+
+#endif /* CONFIG_ZMOD_LOG_STORAGE_STAGING */
+
+int zmod_log_storage_add_data(const void *buf, size_t buf_size)
+{
+    if (buf == NULL) {
+        return -EINVAL;
+    }
+
+    if (buf_size == 0U) {
+        return 0;
+    }
+
+#ifdef CONFIG_ZMOD_LOG_STORAGE_PANIC_SECTOR
+    if (prv_inst.panic) {
+        return prv_panic_write(buf, buf_size);
+    }
+#endif
+
+#ifdef CONFIG_ZMOD_LOG_STORAGE_STAGING
+    if (buf_size > LOG_STORAGE_RING_MAX_RECORD) {
+        atomic_inc(&prv_inst.ring_dropped_records);
+        atomic_add(&prv_inst.ring_dropped_bytes, (atomic_val_t)buf_size);
+        return -ENOMEM;
+    }
+
+    uint8_t *dst = prv_ring_reserve(buf_size, 0);
+
+    if (dst == NULL) {
+        return -ENOMEM;
+    }
+
+    memcpy(dst, buf, buf_size);
+    prv_ring_commit(dst);
+
+    return 0;
+#else
+    int ret = prv_append_record(buf, buf_size);
+
+    if (ret == -EAGAIN) {
+        atomic_inc(&prv_inst.stats.export_dropped);
+    }
+
+    return ret;
+#endif
+}
+
+void *zmod_log_storage_reserve(size_t len)
+{
+#ifdef CONFIG_ZMOD_LOG_STORAGE_STAGING
+    if ((prv_inst.fa == NULL) || (len == 0U) || (len > LOG_STORAGE_RING_MAX_RECORD)) {
+        return NULL;
+    }
+
+#ifdef CONFIG_ZMOD_LOG_STORAGE_PANIC_SECTOR
+    /* Nothing drains the ring after a panic. */
+    if (prv_inst.panic) {
+        return NULL;
+    }
+#endif
+
+    return prv_ring_reserve(len, 0);
+#else
+    ARG_UNUSED(len);
+    return NULL;
+#endif
+}
+
+void zmod_log_storage_commit(void *buf)
+{
+#ifdef CONFIG_ZMOD_LOG_STORAGE_STAGING
+    if (buf != NULL) {
+        prv_ring_commit(buf);
+    }
+#else
+    ARG_UNUSED(buf);
+#endif
+}
+
+int zmod_log_storage_add_priority(const void *buf, size_t buf_size)
+{
+#ifdef CONFIG_ZMOD_LOG_STORAGE_PRIORITY_TIER
+    if (buf == NULL) {
+        return -EINVAL;
+    }
+
+    if ((buf_size == 0U) || (prv_inst.fa == NULL)) {
+        return 0;
+    }
+
+#ifdef CONFIG_ZMOD_LOG_STORAGE_PANIC_SECTOR
+    /* The same line already reaches the panic sector through the main tier. */
+    if (prv_inst.panic) {
+        return 0;
+    }
+#endif
+
+    if (buf_size > LOG_STORAGE_RING_MAX_RECORD) {
+        atomic_inc(&prv_inst.ring_dropped_records);
+        atomic_add(&prv_inst.ring_dropped_bytes, (atomic_val_t)buf_size);
+        return -ENOMEM;
+    }
+
+    uint8_t *dst = prv_ring_reserve(buf_size, LOG_STORAGE_RING_PRIORITY);
+
+    if (dst == NULL) {
+        return -ENOMEM;
+    }
+
+    memcpy(dst, buf, buf_size);
+    prv_ring_commit(dst);
+
+    return 0;
+#else
+    ARG_UNUSED(buf);
+    ARG_UNUSED(buf_size);
+    return -ENOTSUP;
+#endif
+}
+
+void zmod_log_storage_get_drops(zmod_log_storage_drops_t *drops)
+{
+    if (drops == NULL) {
+        return;
+    }
+
+    memset(drops, 0, sizeof(*drops));
+#ifdef CONFIG_ZMOD_LOG_STORAGE_STAGING
+    drops->ring_full_records = (uint32_t)atomic_get(&prv_inst.ring_dropped_records);
+    drops->ring_full_bytes = (uint32_t)atomic_get(&prv_inst.ring_dropped_bytes);
+    drops->write_failed_bytes = (uint32_t)atomic_get(&prv_inst.staging_dropped);
+#endif
+#ifdef CONFIG_ZMOD_LOG_STORAGE_PANIC_SECTOR
+    drops->panic_full_bytes = (uint32_t)atomic_get(&prv_inst.panic_dropped);
+#endif
+}
+
+int zmod_log_storage_get_stats(zmod_log_storage_stats_t *stats)
+{
+    if (stats == NULL) {
+        return -EINVAL;
+    }
+
+    if (prv_inst.fa == NULL) {
+        return -ENODEV;
+    }
+
+    if (prv_lock() < 0) {
+        return -EBUSY;
+    }
+
+    const prv_log_storage_stats_t *src = &prv_inst.stats;
+
+    memset(stats, 0, sizeof(*stats));
+    stats->bytes_written = src->bytes_written;
+    stats->records_written = src->records_written;
+    stats->rotations = src->rotations;
+    stats->fetch_bytes = src->fetch_bytes;
+    stats->append_max_us = k_cyc_to_us_floor32(src->append_cycles_max);
+    stats->append_avg_us = (src->append_count > 0U)
+                               ? k_cyc_to_us_floor32((uint32_t)(src->append_cycles_total / src->append_count))
+                               : 0U;
+
+    for (size_t i = 0U; i < ARRAY_SIZE(src->erases); i++) {
+        stats->erases += src->erases[i];
+    }
+
+    k_mutex_unlock(&prv_inst.mutex);
+
+    stats->mutex_timeouts = (uint32_t)atomic_get(&prv_inst.stats.mutex_timeouts);
+    stats->export_dropped_records = (uint32_t)atomic_get(&prv_inst.stats.export_dropped);
+    zmod_log_storage_get_drops(&stats->drops);
+
+    return 0;
+}
+
+size_t zmod_log_storage_get_erase_counts(uint32_t *counts, size_t max_counts)
+{
+    if ((counts == NULL) || (prv_inst.fa == NULL)) {
+        return 0U;
+    }
+
+    size_t n = MIN(max_counts, ARRAY_SIZE(prv_inst.stats.erases));
+
+    (void)k_mutex_lock(&prv_inst.mutex, K_FOREVER);
+    memcpy(counts, prv_inst.stats.erases, n * sizeof(counts[0]));
+    k_mutex_unlock(&prv_inst.mutex);
+
+    return n;
+}
+
+#ifdef CONFIG_ZMOD_LOG_STORAGE_WEAR
+int zmod_log_storage_get_wear(struct zmod_log_storage_wear_event *wear)
+{
+    if (wear == NULL) {
+        return -EINVAL;
+    }
+
+    if (prv_inst.fa == NULL) {
+        return -ENODEV;
+    }
+
+    if (prv_lock() < 0) {
+        return -EBUSY;
+    }
+
+    uint32_t now_s = prv_wear_uptime();
+
+    prv_wear_window_roll(now_s);
+    prv_wear_summarize(&prv_inst.wear, now_s, wear);
+
+    k_mutex_unlock(&prv_inst.mutex);
+
+    return 0;
+}
+
+size_t zmod_log_storage_get_wear_counts(uint32_t *counts, size_t max_counts)
+{
+    if ((counts == NULL) || (prv_inst.fa == NULL)) {
+        return 0U;
+    }
+
+    size_t n = MIN(max_counts, LOG_STORAGE_NUM_SECTORS);
+
+    (void)k_mutex_lock(&prv_inst.mutex, K_FOREVER);
+    memcpy(counts, prv_inst.wear.erases, n * sizeof(counts[0]));
+    k_mutex_unlock(&prv_inst.mutex);
+
+    return n;
+}
+
+bool zmod_log_storage_wear_throttled(uint8_t level)
+{
+    atomic_val_t limit = atomic_get(&prv_inst.wear_level);
+
+    if ((limit == 0) || ((level != LOG_LEVEL_NONE) && (level <= limit))) {
+        return false;
+    }
+
+    atomic_inc(&prv_inst.wear_dropped);
+    return true;
+}
+#endif /* CONFIG_ZMOD_LOG_STORAGE_WEAR */
+
+int zmod_log_storage_flush(void)
+{
+    if (prv_inst.fa == NULL) {
+        return -ENODEV;
+    }
+
+#ifdef CONFIG_ZMOD_LOG_STORAGE_PANIC_SECTOR
+    /* Panic writes go straight to flash; the normal path may block or erase. */
+    if (prv_inst.panic) {
+        return 0;
+    }
+#endif
+
+#ifdef CONFIG_ZMOD_LOG_STORAGE_STAGING
+    return prv_staging_flush(true);
+#else
+    return 0;
+#endif
+}
+
+int zmod_log_storage_panic(void)
+{
+    if (prv_inst.fa == NULL) {
+        return -ENODEV;
+    }
+
+#ifdef CONFIG_ZMOD_LOG_STORAGE_PANIC_SECTOR
+    if (prv_inst.panic_sector == NULL) {
+        return zmod_log_storage_flush();
+    }
+
+    if (prv_inst.panic) {
+        return 0;
+    }
+    prv_inst.panic = true;
+
+#ifdef CONFIG_ZMOD_LOG_STORAGE_STAGING
+    /* Data the flusher had not written yet goes first, oldest first. */
+#ifdef CONFIG_ZMOD_LOG_STORAGE_COMPRESSION
+    (void)prv_panic_write(prv_inst.pack_raw, prv_inst.raw_len);
+#else
+    (void)prv_panic_write(&prv_inst.pack_buf[sizeof(prv_log_container_hdr_t)], prv_inst.pack_hdr.payload_len);
+#endif
+
+    const uint8_t *rec;
+    size_t len;
+    bool priority;
+
+    while ((rec = prv_ring_peek(&len, &priority)) != NULL) {
+        /* Priority records duplicate main-tier lines; write each line once. */
+        if (!priority) {
+            (void)prv_panic_write(&rec[prv_inst.ring_off], len - prv_inst.ring_off);
+        }
+        prv_inst.ring_off = 0U;
+        prv_ring_release(len);
+    }
+#ifdef CONFIG_ZMOD_LOG_STORAGE_RETAINED_RAM
+    /* Everything staged is now in the panic sector. */
+    atomic_set(&prv_retained.flushed, atomic_get(&prv_retained.head));
+#endif
+#endif
+    return 0;
+#else
+    return zmod_log_storage_flush();
+#endif
+}
+
+/**
+ * @brief Check and clear a pending -ESTALE report. Caller holds the mutex.
+ *
+ * The default cursor keeps the original fetch API semantics and silently
+ * continues from the oldest entry.
+ */
+static bool prv_cursor_take_stale(zmod_log_storage_read_ctx_t *ctx)
+{
+    bool stale = ctx->stale && ctx->in_use;
+
+    ctx->stale = false;
+    return stale;
+}
+
+/** @brief Step @p ctx to the next entry with unread log bytes. Caller holds the mutex. */
+static int prv_cursor_advance(zmod_log_storage_read_ctx_t *ctx)
+{
+    while (ctx->head.fe_sector == NULL || ctx->read_bytes == ctx->info.len) {
+        ctx->read_bytes = 0;
+        ctx->info.len = 0U;
+
+        int ret = prv_read_next(ctx);
+
+        if (ret < 0) {
+            return ret;
+        }
+
+        ret = prv_entry_payload(&ctx->head, &ctx->info);
+
+        if (ret < 0) {
+            LOG_ERR("Failed to read entry header %d", ret);
+            return -EIO;
+        }
+
+        if (ctx->skip_bytes > 0U) {
+            ctx->read_bytes = MIN(ctx->skip_bytes, ctx->info.len);
+            ctx->skip_bytes -= ctx->read_bytes;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Fetch the next chunk of expanded log bytes through @p ctx.
+ *
+ * The mutex is held for one chunk only, so readers interleave with each other
+ * and with the flusher.
+ */
+static int prv_cursor_fetch(zmod_log_storage_read_ctx_t *ctx, void *dst, size_t dest_size, size_t *out_size)
+{
+    if (dst == NULL || out_size == NULL) {
+        return -EINVAL;
+    }
+
+    int ret = prv_lock();
+    if (ret < 0) {
+        LOG_WRN("Failed to lock mutex.");
+        return -EBUSY;
+    }
+
+    prv_span_release(ctx);
+
+    if (prv_cursor_take_stale(ctx)) {
+        k_mutex_unlock(&prv_inst.mutex);
+        return -ESTALE;
+    }
+
+    struct fcb_entry *loc = &ctx->head;
+
+    ret = prv_cursor_advance(ctx);
+    if (ret < 0) {
+        k_mutex_unlock(&prv_inst.mutex);
+        return ret;
+    }
+
+    uint16_t len = ctx->info.len - ctx->read_bytes;
+    if (len > dest_size) {
+        len = dest_size;
+    }
+
+    ret = prv_entry_read(loc, &ctx->info, ctx->read_bytes, dst, len);
+
+    if (ret < 0) {
+        LOG_ERR("Failed to read from flash %d", ret);
+        k_mutex_unlock(&prv_inst.mutex);
+        return -EIO;
+    }
+
+    ctx->read_bytes += len;
+    *out_size = len;
+    prv_inst.stats.fetch_bytes += len;
+
+    k_mutex_unlock(&prv_inst.mutex);
+
+    return ret;
+}
+
+/**
+ * @brief CPU address of the logging partition, or NULL if it cannot be read in place.
+ *
+ * Only SoC flash behind the chosen flash controller is memory-mapped, at
+ * CONFIG_FLASH_BASE_ADDRESS. External SPI/QSPI flash goes through the driver.
+ */
+static const uint8_t *prv_flash_mapped_base(void)
+{
+#if defined(CONFIG_FLASH_BASE_ADDRESS) && DT_HAS_CHOSEN(zephyr_flash_controller)
+    if (prv_inst.fa->fa_dev == DEVICE_DT_GET(DT_CHOSEN(zephyr_flash_controller))) {
+        return (const uint8_t *)(uintptr_t)(CONFIG_FLASH_BASE_ADDRESS + prv_inst.fa->fa_off);
+    }
+#endif
+    return NULL;
+}
+
+/**
+ * @brief Return the next span of expanded log bytes through @p ctx without copying.
+ *
+ * On memory-mapped flash the span is the rest of the current entry's payload,
+ * in place, and its sector is pinned until the next call on @p ctx. Otherwise,
+ * and for compressed containers, up to LOG_STORAGE_SPAN_BOUNCE_SIZE bytes are
+ * read into the cursor's bounce buffer.
+ */
+static int prv_cursor_span(zmod_log_storage_read_ctx_t *ctx, const void **data, size_t *len)
+{
+    if (data == NULL || len == NULL) {
+        return -EINVAL;
+    }
+
+    int ret = prv_lock();
+    if (ret < 0) {
+        LOG_WRN("Failed to lock mutex.");
+        return -EBUSY;
+    }
+
+    prv_span_release(ctx);
+
+    if (prv_cursor_take_stale(ctx)) {
+        k_mutex_unlock(&prv_inst.mutex);
+        return -ESTALE;
+    }
+
+    ret = prv_cursor_advance(ctx);
+    if (ret < 0) {
+        k_mutex_unlock(&prv_inst.mutex);
+        return ret;
+    }
+
+    const uint8_t *mapped = prv_flash_mapped_base();
+    size_t n = ctx->info.len - ctx->read_bytes;
+
+    if ((mapped != NULL) && ((ctx->info.flags & LOG_STORAGE_CONTAINER_FLAG_LZ4) == 0U)) {
+        *data = &mapped[FCB_ENTRY_FA_DATA_OFF(ctx->head) + ctx->info.off + ctx->read_bytes];
+        /* Held until the next call on this cursor, so rotation cannot erase it under the caller. */
+        ctx->span_sector = ctx->head.fe_sector;
+    } else {
+        n = MIN(n, sizeof(ctx->bounce));
+        ret = prv_entry_read(&ctx->head, &ctx->info, ctx->read_bytes, ctx->bounce, n);
+        if (ret < 0) {
+            LOG_ERR("Failed to read from flash %d", ret);
+            k_mutex_unlock(&prv_inst.mutex);
+            return -EIO;
+        }
+        *data = ctx->bounce;
+    }
+
+    ctx->read_bytes += n;
+    *len = n;
+    prv_inst.stats.fetch_bytes += n;
+
+    k_mutex_unlock(&prv_inst.mutex);
+    return 0;
+}
+
+/** @brief Fetch the next chunk of length-prefixed stored entries through @p ctx. */
+static int prv_cursor_fetch_raw(zmod_log_storage_read_ctx_t *ctx, void *dst, size_t dest_size, size_t *out_size)
+{
+    if (dst == NULL || out_size == NULL || dest_size <= sizeof(uint16_t)) {
+        return -EINVAL;
+    }
+
+    int ret = prv_lock();
+    if (ret < 0) {
+        LOG_WRN("Failed to lock mutex.");
+        return -EBUSY;
+    }
+
+    prv_span_release(ctx);
+
+    if (prv_cursor_take_stale(ctx)) {
+        k_mutex_unlock(&prv_inst.mutex);
+        return -ESTALE;
+    }
+
+    struct fcb_entry *loc = &ctx->head;
+    uint8_t *out = dst;
+    size_t produced = 0U;
+
+    if (loc->fe_sector == NULL || ctx->read_bytes == ctx->info.stored_len) {
+        ret = prv_read_next(ctx);
+
+        if (ret < 0) {
+            k_mutex_unlock(&prv_inst.mutex);
+            return ret;
+        }
+
+        /* Raw mode streams whole entries, each behind its little-endian length. */
+        memset(&ctx->info, 0, sizeof(ctx->info));
+        ctx->info.stored_len = loc->fe_data_len;
+        ctx->read_bytes = 0U;
+        sys_put_le16(loc->fe_data_len, out);
+        produced = sizeof(uint16_t);
+    }
+
+    size_t len = MIN(ctx->info.stored_len - ctx->read_bytes, dest_size - produced);
+
+    ret = flash_area_read(prv_inst.fa, FCB_ENTRY_FA_DATA_OFF((*loc)) + ctx->read_bytes, &out[produced], len);
+    if (ret < 0) {
+        LOG_ERR("Failed to read from flash %d", ret);
+        k_mutex_unlock(&prv_inst.mutex);
+        return -EIO;
+    }
+
+    ctx->read_bytes += len;
+    *out_size = produced + len;
+    prv_inst.stats.fetch_bytes += *out_size;
+
+    k_mutex_unlock(&prv_inst.mutex);
+    return 0;
+}
+
+/**
+ * @brief Restart @p ctx inside a log-clock window.
+ *
+ * With the time index the cursor jumps to the first sector overlapping the
+ * window; otherwise entries outside it are skipped while reading. Only staged
+ * containers carry timestamps, so without staging there is nothing to match.
+ */
+static int prv_cursor_seek(zmod_log_storage_read_ctx_t *ctx, uint32_t since_ms, uint32_t until_ms)
+{
+    if (!IS_ENABLED(CONFIG_ZMOD_LOG_STORAGE_STAGING)) {
+        return -ENOTSUP;
+    }
+
+    if (since_ms > until_ms) {
+        return -EINVAL;
+    }
+
+    int ret = prv_lock();
+    if (ret < 0) {
+        LOG_WRN("Failed to lock mutex.");
+        return -EBUSY;
+    }
+
+    prv_cursor_rewind(ctx);
+    ctx->range.active = true;
+    ctx->range.since_ms = since_ms;
+    ctx->range.until_ms = until_ms;
+
+#ifdef CONFIG_ZMOD_LOG_STORAGE_TIME_INDEX
+    /* The index covers the main tier; priority cursors filter while reading. */
+    if (ctx->fcb == &prv_inst.fcb_inst) {
+        ret = prv_time_seek(&ctx->range, &ctx->head);
+        if (ret < 0) {
+            /* Park the cursor on an empty window so fetches report -ENOENT. */
+            ctx->range.since_ms = UINT32_MAX;
+            ctx->range.until_ms = 0U;
+        }
+    }
+#endif
+
+    k_mutex_unlock(&prv_inst.mutex);
+    return ret;
+}
+
+#ifdef CONFIG_ZMOD_LOG_STORAGE_TAIL
+/**
+ * @brief Restart @p ctx at the newest @p count records, or log bytes when @p bytes is set.
+ *
+ * The per-sector totals of the index are walked back from the active sector
+ * in RAM, so only the sector the tail starts in has its entry headers read.
+ * A raw entry is one record; a container holds one per staged chunk, and
+ * record counts round out to whole containers. Byte counts are exact.
+ */
+static int prv_cursor_tail(zmod_log_storage_read_ctx_t *ctx, uint32_t count, bool bytes)
+{
+    if (ctx->fcb != &prv_inst.fcb_inst) {
+        return -ENOTSUP;
+    }
+
+    int ret = prv_lock();
+    if (ret < 0) {
+        LOG_WRN("Failed to lock mutex.");
+        return -EBUSY;
+    }
+
+    struct fcb *fcb = ctx->fcb;
+    struct flash_sector *sector = fcb->f_active.fe_sector;
+    uint32_t need = count;
+
+    prv_cursor_rewind(ctx);
+    memset(&ctx->range, 0, sizeof(ctx->range));
+    prv_index_build();
+
+    while (true) {
+        const prv_sector_index_t *idx = &prv_inst.index[sector - prv_inst.sectors];
+        uint32_t have = bytes ? idx->log_bytes : idx->record_count;
+
+        if (have >= need) {
+            need = have - need;
+            break;
+        }
+        if (sector == fcb->f_oldest) {
+            /* Fewer than @p count stored: read everything. */
+            k_mutex_unlock(&prv_inst.mutex);
+            return 0;
+        }
+        need -= have;
+        sector = prv_sector_prev(fcb, sector);
+    }
+
+    /* need now counts what to skip at the start of the sector. */
+    struct fcb_entry loc = {.fe_sector = sector, .fe_elem_off = 0U};
+    struct fcb_entry prev = loc;
+    prv_log_container_hdr_t hdr;
+
+    while ((fcb_getnext(fcb, &loc) == 0) && (loc.fe_sector == sector)) {
+        uint32_t log_bytes = 0U;
+
+        ret = prv_entry_tally(&loc, &hdr, &log_bytes);
+        if (ret < 0) {
+            LOG_ERR("Failed to read entry header %d", ret);
+            k_mutex_unlock(&prv_inst.mutex);
+            return -EIO;
+        }
+
+        uint32_t n = bytes ? log_bytes : ((ret > 0) ? hdr.record_count : 1U);
+
+        if (n > need) {
+            break;
+        }
+        need -= n;
+        prev = loc;
+    }
+
+    /* The next read returns the entry after prev, dropping what remains to skip. */
+    ctx->head = prev;
+    ctx->skip_bytes = bytes ? need : 0U;
+
+    k_mutex_unlock(&prv_inst.mutex);
+    return 0;
+}
+#endif
+
+/** @brief Check that @p cursor is an open cursor from the pool. */
+static bool prv_cursor_valid(const zmod_log_storage_cursor_t *cursor)
+{
+    return (cursor >= &prv_inst.cursors[0]) && (cursor < &prv_inst.cursors[ARRAY_SIZE(prv_inst.cursors)]) &&
+           cursor->in_use;
+}
+
+int zmod_log_storage_fetch_data(void *dst, size_t dest_size, size_t *out_size)
+{
+    return prv_cursor_fetch(&prv_inst.read_head, dst, dest_size, out_size);
+}
+
+int zmod_log_storage_fetch_raw(void *dst, size_t dest_size, size_t *out_size)
+{
+    return prv_cursor_fetch_raw(&prv_inst.read_head, dst, dest_size, out_size);
+}
+
+int zmod_log_storage_fetch_span(const void **data, size_t *len)
+{
+    return prv_cursor_span(&prv_inst.read_head, data, len);
+}
+
+int zmod_log_storage_seek_time(uint32_t since_ms, uint32_t until_ms)
+{
+#ifdef CONFIG_ZMOD_LOG_STORAGE_TIME_INDEX
+    return prv_cursor_seek(&prv_inst.read_head, since_ms, until_ms);
+#else
+    ARG_UNUSED(since_ms);
+    ARG_UNUSED(until_ms);
+    return -ENOTSUP;
+#endif
+}
+
+int zmod_log_storage_seek_tail(uint32_t count, bool bytes)
+{
+#ifdef CONFIG_ZMOD_LOG_STORAGE_TAIL
+    return prv_cursor_tail(&prv_inst.read_head, count, bytes);
+#else
+    ARG_UNUSED(count);
+    ARG_UNUSED(bytes);
+    return -ENOTSUP;
+#endif
+}
+
+/** @brief Take a pool cursor bounded at the current end of @p fcb. */
+static zmod_log_storage_read_ctx_t *prv_cursor_open(struct fcb *fcb)
+{
+    if (prv_inst.fa == NULL) {
+        return NULL;
+    }
+
+    /* Persist anything staged so the cursor covers everything logged before it was opened. */
+    (void)zmod_log_storage_flush();
+
+    if (prv_lock() < 0) {
+        LOG_WRN("Failed to lock mutex.");
+        return NULL;
+    }
+
+    zmod_log_storage_read_ctx_t *ctx = NULL;
+
+    for (size_t i = 0U; i < ARRAY_SIZE(prv_inst.cursors); i++) {
+        if (!prv_inst.cursors[i].in_use) {
+            ctx = &prv_inst.cursors[i];
+            break;
+        }
+    }
+
+    if (ctx != NULL) {
+        memset(ctx, 0, sizeof(*ctx));
+        ctx->fcb = fcb;
+        ctx->in_use = true;
+        prv_cursor_bound(ctx);
+    }
+
+    k_mutex_unlock(&prv_inst.mutex);
+    return ctx;
+}
+
+zmod_log_storage_cursor_t *zmod_log_storage_cursor_open(void)
+{
+    return prv_cursor_open(&prv_inst.fcb_inst);
+}
+
+zmod_log_storage_cursor_t *zmod_log_storage_priority_cursor_open(void)
+{
+#ifdef CONFIG_ZMOD_LOG_STORAGE_PRIORITY_TIER
+    return prv_cursor_open(&prv_inst.priority_fcb);
+#else
+    return NULL;
+#endif
+}
+
+int zmod_log_storage_cursor_seek_time(zmod_log_storage_cursor_t *cursor, uint32_t since_ms, uint32_t until_ms)
+{
+    if (!prv_cursor_valid(cursor)) {
+        return -EINVAL;
+    }
+
+    return prv_cursor_seek(cursor, since_ms, until_ms);
+}
+
+int zmod_log_storage_cursor_seek_tail(zmod_log_storage_cursor_t *cursor, uint32_t count, bool bytes)
+{
+    if (!prv_cursor_valid(cursor)) {
+        return -EINVAL;
+    }
+
+#ifdef CONFIG_ZMOD_LOG_STORAGE_TAIL
+    return prv_cursor_tail(cursor, count, bytes);
+#else
+    ARG_UNUSED(count);
+    ARG_UNUSED(bytes);
+    return -ENOTSUP;
+#endif
+}
+
+int zmod_log_storage_cursor_fetch(zmod_log_storage_cursor_t *cursor, void *dst, size_t dest_size, size_t *out_size)
+{
+    if (!prv_cursor_valid(cursor)) {
+        return -EINVAL;
+    }
+
+    return prv_cursor_fetch(cursor, dst, dest_size, out_size);
+}
+
+int zmod_log_storage_cursor_fetch_raw(zmod_log_storage_cursor_t *cursor, void *dst, size_t dest_size,
+                                      size_t *out_size)
+{
+    if (!prv_cursor_valid(cursor)) {
+        return -EINVAL;
+    }
+
+    return prv_cursor_fetch_raw(cursor, dst, dest_size, out_size);
+}
+
+int zmod_log_storage_cursor_fetch_span(zmod_log_storage_cursor_t *cursor, const void **data, size_t *len)
+{
+    if (!prv_cursor_valid(cursor)) {
+        return -EINVAL;
+    }
+
+    return prv_cursor_span(cursor, data, len);
+}
+
+void zmod_log_storage_cursor_close(zmod_log_storage_cursor_t *cursor)
+{
+    if (!prv_cursor_valid(cursor)) {
+        return;
+    }
+
+    (void)k_mutex_lock(&prv_inst.mutex, K_FOREVER);
+    prv_span_release(cursor);
+    cursor->in_use = false;
+    k_mutex_unlock(&prv_inst.mutex);
+}
+
+int zmod_log_storage_time_range(uint32_t *oldest_ms, uint32_t *newest_ms)
+{
+#ifdef CONFIG_ZMOD_LOG_STORAGE_TIME_INDEX
+    if (oldest_ms == NULL || newest_ms == NULL) {
+        return -EINVAL;
+    }
+
+    int ret = prv_lock();
+    if (ret < 0) {
+        LOG_WRN("Failed to lock mutex.");
+        return -EBUSY;
+    }
+
+    prv_index_build();
+
+    bool found = false;
+
+    for (size_t i = 0; i < prv_inst.fcb_inst.f_sector_cnt; i++) {
+        const prv_sector_index_t *idx = &prv_inst.index[i];
+
+        if (idx->container_count == 0U) {
+            continue;
+        }
+
+        if (!found || (idx->first_ts_ms < *oldest_ms)) {
+            *oldest_ms = idx->first_ts_ms;
+        }
+        if (!found || (idx->last_ts_ms > *newest_ms)) {
+            *newest_ms = idx->last_ts_ms;
+        }
+        found = true;
+    }
+
+    k_mutex_unlock(&prv_inst.mutex);
+    return found ? 0 : -ENOENT;
+#else
+    ARG_UNUSED(oldest_ms);
+    ARG_UNUSED(newest_ms);
+    return -ENOTSUP;
+#endif
+}
+
+void zmod_log_storage_reset_read(void)
+{
+    /* An export snapshot survives a reset; only the position and window are cleared. */
+    prv_cursor_rewind(&prv_inst.read_head);
+    memset(&prv_inst.read_head.range, 0, sizeof(prv_inst.read_head.range));
+}
+
+int zmod_log_storage_clear(void)
+{
+    (void)prv_lock();
+
+    bool pinned = prv_span_pinned(&prv_inst.fcb_inst, NULL);
+#ifdef CONFIG_ZMOD_LOG_STORAGE_PRIORITY_TIER
+    pinned = pinned || prv_span_pinned(&prv_inst.priority_fcb, NULL);
+#endif
+    if (pinned) {
+        k_mutex_unlock(&prv_inst.mutex);
+        return -EBUSY;
+    }
+
+    int ret = fcb_clear(&prv_inst.fcb_inst);
+    if (ret < 0) {
+        LOG_ERR("Failed to clear FCB: %d", ret);
+        k_mutex_unlock(&prv_inst.mutex);
+        return ret;
+    }
+
+    prv_stats_clear(&prv_inst.fcb_inst);
+    prv_cursors_invalidate(&prv_inst.fcb_inst, NULL);
+#ifdef CONFIG_ZMOD_LOG_STORAGE_PRIORITY_TIER
+    ret = fcb_clear(&prv_inst.priority_fcb);
+    prv_stats_clear(&prv_inst.priority_fcb);
+    prv_cursors_invalidate(&prv_inst.priority_fcb, NULL);
+    if (ret < 0) {
+        LOG_ERR("Failed to clear priority FCB: %d", ret);
+        k_mutex_unlock(&prv_inst.mutex);
+        return ret;
+    }
+#endif
+#ifdef CONFIG_ZMOD_LOG_STORAGE_COMPRESSION
+    prv_inst.decomp_valid = false;
+#endif
+#ifdef CONFIG_ZMOD_LOG_STORAGE_TIME_INDEX
+    prv_inst.index_valid = false;
+#endif
+    prv_meta_persist();
+
+    k_mutex_unlock(&prv_inst.mutex);
+    return 0;
+}
+
+void zmod_log_storage_set_export_in_progress(bool in_progress)
+{
+    if (in_progress) {
+        /* Persist anything staged before the export starts so it is included. */
+        (void)zmod_log_storage_flush();
+    }
+
+    (void)k_mutex_lock(&prv_inst.mutex, K_FOREVER);
+
+    if (in_progress) {
+        /* Entries appended from here on lie beyond the snapshot. */
+        prv_cursor_bound(&prv_inst.read_head);
+    } else {
+        prv_inst.read_head.bounded = false;
+        prv_inst.read_head.at_end = false;
+    }
+    prv_inst.snapshot_active = in_progress;
+    prv_inst.export_in_progress = in_progress;
+
+    k_mutex_unlock(&prv_inst.mutex);
+
+#ifdef CONFIG_ZMOD_LOG_STORAGE_STAGING
+    if (!in_progress) {
+        /* Write out anything held back while the snapshot pinned the oldest sector. */
+        k_sem_give(&prv_inst.flush_sem);
+    }
+#endif
+}
+
+/**
+ * @brief Set the runtime level of one source for every backend but flash storage.
+ *
+ * Without a storage filter the flash backend follows the runtime level too.
+ *
+ * @return Level actually applied, limited by the source's compiled level.
+ */
+static uint32_t prv_runtime_filter_set(uint32_t source_id, uint8_t level)
+{
+#ifdef CONFIG_ZMOD_LOG_STORAGE_BACKEND_FILTER
+    const struct log_backend *flash_backend = zmod_flash_log_backend_get();
+    uint32_t result = level;
+
+    for (int i = 0; i < log_backend_count_get(); i++) {
+        const struct log_backend *backend = log_backend_get(i);
+
+        if (backend != flash_backend) {
+            result = log_filter_set(backend, Z_LOG_LOCAL_DOMAIN_ID, source_id, level);
+        }
+    }
+
+    return result;
+#else
+    return log_filter_set(NULL, Z_LOG_LOCAL_DOMAIN_ID, source_id, level);
+#endif
+}
+
+#ifdef CONFIG_ZMOD_LOG_STORAGE_BACKEND_FILTER
+/** @brief Runtime level persisted in the config store, before clamping. */
+static uint8_t prv_runtime_level(void)
+{
+    uint8_t log_level;
+
+    if (!zmod_config_mgr_get_value(CFG_LOG_LEVEL, &log_level, sizeof(log_level)) || (log_level > LOG_LEVEL_DBG)) {
+        log_level = CONFIG_LOG_DEFAULT_LEVEL;
+    }
+
+    return log_level;
+}
+
+/** @brief Build-independent identifier of a log source: CRC32 of its name. */
+static uint32_t prv_source_hash(uint32_t source_id)
+{
+    const char *name = log_source_name_get(Z_LOG_LOCAL_DOMAIN_ID, source_id);
+
+    return (name != NULL) ? crc32_ieee((const uint8_t *)name, strlen(name)) : 0U;
+}
+
+/** @brief Read the persisted storage filter; an unset filter reads as all zero. */
+static void prv_storage_filter_load(zmod_log_storage_filter_t *filter)
+{
+    if (!zmod_config_mgr_get_value(CFG_LOG_STORAGE_FILTER, filter, sizeof(*filter))) {
+        memset(filter, 0, sizeof(*filter));
+    }
+
+    filter->count = MIN(filter->count, ARRAY_SIZE(filter->source_hash));
+}
+
+/** @brief Storage level of @p source_id, or @p runtime_level while no filter is configured. */
+static uint8_t prv_storage_level(const zmod_log_storage_filter_t *filter, uint32_t source_id, uint8_t runtime_level)
+{
+    if (!filter->configured) {
+        return runtime_level;
+    }
+
+    uint32_t hash = prv_source_hash(source_id);
+
+    for (size_t i = 0U; i < filter->count; i++) {
+        if (filter->source_hash[i] == hash) {
+            return filter->level[i];
+        }
+    }
+
+    return filter->default_level;
+}
+
+/** @brief Program the flash backend's per-source filter table. */
+static void prv_storage_filter_apply(uint8_t runtime_level)
+{
+    const struct log_backend *backend = zmod_flash_log_backend_get();
+    zmod_log_storage_filter_t filter;
+    uint32_t source_count = log_src_cnt_get(Z_LOG_LOCAL_DOMAIN_ID);
+
+    prv_storage_filter_load(&filter);
+
+    for (uint32_t source_id = 0; source_id < source_count; source_id++) {
+        (void)log_filter_set(backend,
+                             Z_LOG_LOCAL_DOMAIN_ID,
+                             source_id,
+                             prv_storage_level(&filter, source_id, runtime_level));
+    }
+}
+#endif /* CONFIG_ZMOD_LOG_STORAGE_BACKEND_FILTER */
+
+void zmod_log_storage_init_log_level(void)
+{
+    uint8_t log_level;
+
+    if (!zmod_config_mgr_get_value(CFG_LOG_LEVEL, &log_level, sizeof(log_level)) || (log_level > LOG_LEVEL_DBG)) {
+        log_level = CONFIG_LOG_DEFAULT_LEVEL;
+        zmod_config_mgr_set_value(CFG_LOG_LEVEL, &log_level, sizeof(log_level));
+    }
+
+    if (log_level < LOG_RUNTIME_MIN_LEVEL) {
+        log_level = LOG_RUNTIME_MIN_LEVEL;
+        LOG_WRN("Persisted log level is below minimum; clamping to %u", log_level);
+        zmod_config_mgr_set_value(CFG_LOG_LEVEL, &log_level, sizeof(log_level));
+    }
+
+    uint32_t source_count = log_src_cnt_get(Z_LOG_LOCAL_DOMAIN_ID);
+    uint32_t set_count = 0;
+
+    for (uint32_t source_id = 0; source_id < source_count; source_id++) {
+        uint32_t result_level = prv_runtime_filter_set(source_id, log_level);
+        if (result_level == log_level) {
+            set_count++;
+        }
+    }
+
+#ifdef CONFIG_ZMOD_LOG_STORAGE_BACKEND_FILTER
+    prv_storage_filter_apply(log_level);
+#endif
+
+#ifdef CONFIG_ZMOD_LOG_STORAGE_WEAR
+    if (prv_inst.fa != NULL) {
+        prv_inst.wear_config_ready = true;
+        (void)k_work_reschedule(&prv_inst.wear_work, K_NO_WAIT);
+    }
+#endif
+
+    LOG_INF("Log level initialized: %u (applied to %u/%u modules)", log_level, set_count, source_count);
+}
+
+int zmod_log_storage_set_log_level(uint8_t level)
+{
+    if (level > LOG_LEVEL_DBG) {
+        LOG_ERR("Invalid log level: %u. Valid levels: %u=ERR, %u=WRN, %u=INF, %u=DBG",
+                level,
+                LOG_LEVEL_ERR,
+                LOG_LEVEL_WRN,
+                LOG_LEVEL_INF,
+                LOG_LEVEL_DBG);
+        return -EINVAL;
+    }
+
+    uint8_t clamped_level = level;
+    if (clamped_level < LOG_RUNTIME_MIN_LEVEL) {
+        clamped_level = LOG_RUNTIME_MIN_LEVEL;
+    }
+
+    uint32_t source_count = log_src_cnt_get(Z_LOG_LOCAL_DOMAIN_ID);
+
+    for (uint32_t source_id = 0; source_id < source_count; source_id++) {
+        (void)prv_runtime_filter_set(source_id, clamped_level);
+    }
+
+#ifdef CONFIG_ZMOD_LOG_STORAGE_BACKEND_FILTER
+    /* Sources that follow the runtime level pick up the change. */
+    prv_storage_filter_apply(clamped_level);
+#endif
+
+    if (!zmod_config_mgr_set_value(CFG_LOG_LEVEL, &clamped_level, sizeof(clamped_level))) {
+        LOG_ERR("Failed to save log level to config");
+        return -EIO;
+    }
+
+    if (clamped_level != level) {
+        LOG_WRN("Requested level %u clamped to minimum runtime level %u", level, clamped_level);
+    }
+
+    const char *level_name = prv_get_log_level_name(clamped_level);
+    LOG_INF("Log level set to: %s (%u)", level_name, clamped_level);
+
+    return 0;
+}
+
+int zmod_log_storage_set_storage_level(const char *source, uint8_t level)
+{
+#ifdef CONFIG_ZMOD_LOG_STORAGE_BACKEND_FILTER
+    if (level > LOG_LEVEL_DBG) {
+        return -EINVAL;
+    }
+
+    level = MAX(level, LOG_RUNTIME_MIN_LEVEL);
+
+    zmod_log_storage_filter_t filter;
+    uint8_t runtime_level = MAX(prv_runtime_level(), LOG_RUNTIME_MIN_LEVEL);
+
+    prv_storage_filter_load(&filter);
+
+    if (!filter.configured) {
+        /* Sources without an override keep following what they stored so far. */
+        memset(&filter, 0, sizeof(filter));
+        filter.configured = 1U;
+        filter.default_level = runtime_level;
+    }
+
+    if (source == NULL) {
+        filter.default_level = level;
+        filter.count = 0U;
+    } else {
+        uint32_t source_count = log_src_cnt_get(Z_LOG_LOCAL_DOMAIN_ID);
+        uint32_t source_id = 0;
+
+        for (; source_id < source_count; source_id++) {
+            const char *name = log_source_name_get(Z_LOG_LOCAL_DOMAIN_ID, source_id);
+
+            if ((name != NULL) && (strcmp(name, source) == 0)) {
+                break;
+            }
+        }
+
+        if (source_id == source_count) {
+            return -ENOENT;
+        }
+
+        uint32_t hash = prv_source_hash(source_id);
+        size_t slot = 0U;
+
+        while ((slot < filter.count) && (filter.source_hash[slot] != hash)) {
+            slot++;
+        }
+
+        if (slot == ARRAY_SIZE(filter.source_hash)) {
+            return -ENOMEM;
+        }
+
+        filter.source_hash[slot] = hash;
+        filter.level[slot] = level;
+        filter.count = MAX(filter.count, slot + 1U);
+    }
+
+    if (!zmod_config_mgr_set_value(CFG_LOG_STORAGE_FILTER, &filter, sizeof(filter))) {
+        LOG_ERR("Failed to save storage filter to config");
+        return -EIO;
+    }
+
+    prv_storage_filter_apply(runtime_level);
+    LOG_INF("Storage level for %s set to %s", (source != NULL) ? source : "all modules", prv_get_log_level_name(level));
+
+    return 0;
+#else
+    ARG_UNUSED(source);
+    ARG_UNUSED(level);
+    return -ENOTSUP;
+#endif
+}
+
+#ifdef CONFIG_SHELL
+
+#include <zephyr/shell/shell.h>
+
+/** @brief Shell command handler that reports export-in-progress state. */
+static int prv_shell_print_export_status(const struct shell *sh, size_t argc, char **argv)
+{
+    ARG_UNUSED(argc);
+    ARG_UNUSED(argv);
+
+    shell_print(sh, "Log export in progress: %s", prv_inst.export_in_progress ? "true" : "false");
+    return 0;
+}
+
+/** @brief Shell command handler to erase all stored log entries. */
+static int prv_shell_log_storage_clear(const struct shell *sh, size_t argc, char **argv)
+{
+    ARG_UNUSED(argc);
+    ARG_UNUSED(argv);
+
+    shell_print(sh, "Clearing stored logs...");
+
+    int ret = zmod_log_storage_clear();
+
+    if (ret < 0) {
+        shell_error(sh, "Failed to clear logs: %d", ret);
+        return ret;
+    }
+
+    shell_print(sh, "Stored logs cleared.");
+    return 0;
+}
+
+/**
+ * @brief Parse the optional "--since <ms>" and "--until <ms>" export arguments.
+ *
+ * Times are on the log clock. A negative --since counts back from the newest
+ * stored container, e.g. "--since -600000" for the last ten minutes. Windows
+ * need staging, which timestamps the containers, and a negative --since also
+ * needs the time index.
+ */
+static int prv_shell_parse_range(const struct shell *sh, size_t argc, char **argv, prv_time_range_t *range)
+{
+    long long since = 0;
+    long long until = UINT32_MAX;
+
+    memset(range, 0, sizeof(*range));
+
+    for (size_t i = 1; i < argc; i += 2) {
+        bool is_since = (strcmp(argv[i], "--since") == 0);
+        bool is_until = (strcmp(argv[i], "--until") == 0);
+        char *end = NULL;
+
+        if ((!is_since && !is_until) || ((i + 1U) >= argc)) {
+            shell_error(sh, "Usage: log_storage export [--since <ms>] [--until <ms>]");
+            return -EINVAL;
+        }
+
+        long long value = strtoll(argv[i + 1U], &end, 0);
+
+        if ((end == argv[i + 1U]) || (*end != '\0')) {
+            shell_error(sh, "Invalid time: %s", argv[i + 1U]);
+            return -EINVAL;
+        }
+
+        if (is_since) {
+            since = value;
+        } else {
+            until = value;
+        }
+    }
+
+    if (argc <= 1U) {
+        return 0;
+    }
+
+    if (!IS_ENABLED(CONFIG_ZMOD_LOG_STORAGE_STAGING)) {
+        shell_error(sh, "--since/--until need CONFIG_ZMOD_LOG_STORAGE_STAGING; raw entries have no timestamps");
+        return -ENOTSUP;
+    }
+
+    if (since < 0) {
+        uint32_t oldest = 0U;
+        uint32_t newest = 0U;
+        int ret = zmod_log_storage_time_range(&oldest, &newest);
+
+        if (ret == -ENOTSUP) {
+            shell_error(sh, "A negative --since needs CONFIG_ZMOD_LOG_STORAGE_TIME_INDEX");
+            return ret;
+        }
+        if (ret < 0) {
+            shell_error(sh, "No stored time range for a relative --since: %d", ret);
+            return ret;
+        }
+
+        since = MAX((long long)newest + since, 0LL);
     }
 
-    k_mutex_unlock(&prv_inst.mutex);
+    range->active = true;
+    range->since_ms = (uint32_t)CLAMP(since, 0LL, (long long)UINT32_MAX);
+    range->until_ms = (uint32_t)CLAMP(until, 0LL, (long long)UINT32_MAX);
+
     return 0;
 }
 
-int zmod_log_storage_fetch_data(void *dst, size_t dest_size, size_t *out_size)
+static int prv_shell_stream(const struct shell *sh, zmod_log_storage_cursor_t *cursor);
+
+/**
+ * @brief Stream one storage tier to the shell.
+ *
+ * Reads through its own cursor, so logging and other readers carry on while
+ * the shell prints; entries logged after the command started are not shown.
+ */
+static int prv_shell_export_tier(const struct shell *sh, size_t argc, char **argv, struct fcb *fcb)
 {
-    if (dst == NULL || out_size == NULL) {
-        return -EINVAL;
-    }
+    prv_time_range_t range;
 
-    int ret = k_mutex_lock(&prv_inst.mutex, K_MSEC(LOG_STORAGE_MUTEX_TIMEOUT_MS));
+    int ret = prv_shell_parse_range(sh, argc, argv, &range);
     if (ret < 0) {
-        LOG_WRN("Failed to lock mutex.");
-        return -EBUSY;
+        return ret;
     }
 
-    zmod_log_storage_read_ctx_t *ctx = &prv_inst.read_head;
-    struct fcb_entry *loc = &prv_inst.read_head.head;
-
-    if (loc->fe_sector == NULL || (loc->fe_sector && ctx->read_bytes == loc->fe_data_len)) {
-        ctx->read_bytes = 0;
-        ret = fcb_getnext(&prv_inst.fcb_inst, loc);
+    zmod_log_storage_cursor_t *cursor = prv_cursor_open(fcb);
+    if (cursor == NULL) {
+        shell_error(sh, "No free log read cursor");
+        return -EBUSY;
+    }
 
+    if (range.active) {
+        ret = prv_cursor_seek(cursor, range.since_ms, range.until_ms);
         if (ret < 0) {
-            k_mutex_unlock(&prv_inst.mutex);
+            if (ret == -ENOENT) {
+                shell_print(sh, "No stored log entries in range.");
+                ret = 0;
+            } else {
+                shell_error(sh, "Unable to apply time window: %d", ret);
+            }
+            zmod_log_storage_cursor_close(cursor);
             return ret;
         }
     }
 
-    uint16_t len = ctx->head.fe_data_len - ctx->read_bytes;
-    if (len > dest_size) {
-        len = dest_size;
-    }
+    return prv_shell_stream(sh, cursor);
+}
 
-    ret = flash_area_read(prv_inst.fa, FCB_ENTRY_FA_DATA_OFF((*loc)) + ctx->read_bytes, dst, len);
+/** @brief Stream everything left in @p cursor to the shell, then close it. */
+static int prv_shell_stream(const struct shell *sh, zmod_log_storage_cursor_t *cursor)
+{
+    const void *span = NULL;
+    size_t out = 0U;
+    bool empty = true;
+    int ret;
 
-    if (ret < 0) {
-        LOG_ERR("Failed to read from flash %d", ret);
-        k_mutex_unlock(&prv_inst.mutex);
-        return -EIO;
-    }
+    while (true) {
+        /* Spans point straight into mapped flash where possible; no copy through a scratch buffer. */
+        ret = prv_cursor_span(cursor, &span, &out);
+        if (ret == -ESTALE) {
+            shell_warn(sh, "Unread logs were rotated out; continuing from the oldest entry.");
+            continue;
+        }
+        if (ret < 0) {
+            break;
+        }
 
-    ctx->read_bytes += len;
-    *out_size = len;
+        empty = false;
+#ifdef CONFIG_ZMOD_LOG_STORAGE_FORMAT_DICTIONARY
+        /* Binary dictionary records are emitted as hex for the host decoder. */
+        const uint8_t *bytes = span;
 
-    k_mutex_unlock(&prv_inst.mutex);
+        for (size_t i = 0U; i < out; i++) {
+            shell_fprintf(sh, SHELL_VT100_COLOR_DEFAULT, "%02x", bytes[i]);
+        }
+        shell_fprintf(sh, SHELL_VT100_COLOR_DEFAULT, "\n");
+#else
+        shell_fprintf(sh, SHELL_VT100_COLOR_DEFAULT, "%.*s", (int)out, (const char *)span);
+#endif
+    }
+
+    if (ret == -ENOENT) {
+        if (empty) {
+            shell_print(sh, "No stored log entries.");
+        }
+        ret = 0;
+    } else {
+        shell_error(sh, "Failed to read log entry: %d", ret);
+    }
 
+    zmod_log_storage_cursor_close(cursor);
     return ret;
 }
 
-void zmod_log_storage_reset_read(void)
+/** @brief Shell command handler that streams stored logs to the shell. */
+static int prv_shell_log_storage_export(const struct shell *sh, size_t argc, char **argv)
 {
-    memset(&prv_inst.read_head, 0, sizeof(prv_inst.read_head));
+    return prv_shell_export_tier(sh, argc, argv, &prv_inst.fcb_inst);
 }
 
-int zmod_log_storage_clear(void)
+#ifdef CONFIG_ZMOD_LOG_STORAGE_PRIORITY_TIER
+/** @brief Shell command handler that streams the priority tier to the shell. */
+static int prv_shell_log_storage_export_priority(const struct shell *sh, size_t argc, char **argv)
 {
-    k_mutex_lock(&prv_inst.mutex, K_MSEC(LOG_STORAGE_MUTEX_TIMEOUT_MS));
+    return prv_shell_export_tier(sh, argc, argv, &prv_inst.priority_fcb);
+}
+#endif
 
-    int ret = fcb_clear(&prv_inst.fcb_inst);
+#ifdef CONFIG_ZMOD_LOG_STORAGE_TAIL
+/** @brief Shell command handler that streams the newest records or bytes. */
+static int prv_shell_log_storage_tail(const struct shell *sh, size_t argc, char **argv)
+{
+    bool bytes = (argc == 3U) && (strcmp(argv[1], "-b") == 0);
+    const char *arg = argv[argc - 1U];
+    char *end = NULL;
+    unsigned long count = strtoul(arg, &end, 0);
+
+    if (((argc == 3U) && !bytes) || (end == arg) || (*end != '\0') || (count > UINT32_MAX)) {
+        shell_error(sh, "usage: log_storage tail [-b] <n>");
+        return -EINVAL;
+    }
+
+    zmod_log_storage_cursor_t *cursor = zmod_log_storage_cursor_open();
+    if (cursor == NULL) {
+        shell_error(sh, "No free log read cursor");
+        return -EBUSY;
+    }
+
+    int ret = prv_cursor_tail(cursor, (uint32_t)count, bytes);
     if (ret < 0) {
-        LOG_ERR("Failed to clear FCB: %d", ret);
-        k_mutex_unlock(&prv_inst.mutex);
+        shell_error(sh, "Unable to seek to the tail: %d", ret);
+        zmod_log_storage_cursor_close(cursor);
         return ret;
     }
 
-    memset(&prv_inst.read_head, 0, sizeof(prv_inst.read_head));
-
-    k_mutex_unlock(&prv_inst.mutex);
-    return 0;
+    return prv_shell_stream(sh, cursor);
 }
+#endif
 
-void zmod_log_storage_set_export_in_progress(bool in_progress)
+/**
+ * @brief Shell command handler that dumps stored entries verbatim as hex.
+ *
+ * Each entry is emitted as its little-endian u16 length followed by the entry
+ * bytes, container headers and compressed payloads included, so the host can
+ * unpack it with scripts/log_raw_decode.py.
+ */
+static int prv_shell_log_storage_export_raw(const struct shell *sh, size_t argc, char **argv)
 {
-    prv_inst.export_in_progress = in_progress;
-}
+    ARG_UNUSED(argc);
+    ARG_UNUSED(argv);
 
-void zmod_log_storage_init_log_level(void)
-{
-    uint8_t log_level;
-    bool use_default = false;
+    uint8_t buffer[64];
+    size_t out = 0U;
+    int ret;
 
-    if (zmod_config_mgr_get_value(CFG_LOG_LEVEL, &log_level, sizeof(log_level))) {
-        if (log_level > LOG_LEVEL_DBG) {
-            use_default = true;
-        }
-    } else {
-        use_default = true;
+    zmod_log_storage_cursor_t *cursor = zmod_log_storage_cursor_open();
+    if (cursor == NULL) {
+        shell_error(sh, "No free log read cursor");
+        return -EBUSY;
     }
 
-    if (use_default) {
-        log_level = CONFIG_LOG_DEFAULT_LEVEL;
-        zmod_config_mgr_set_value(CFG_LOG_LEVEL, &log_level, sizeof(log_level));
-    }
+    while (true) {
+        ret = prv_cursor_fetch_raw(cursor, buffer, sizeof(buffer), &out);
+        if (ret == -ESTALE) {
+            shell_warn(sh, "Unread logs were rotated out; continuing from the oldest entry.");
+            continue;
+        }
+        if (ret < 0) {
+            break;
+        }
 
-    if (log_level < LOG_RUNTIME_MIN_LEVEL) {
-        log_level = LOG_RUNTIME_MIN_LEVEL;
-        LOG_WRN("Persisted log level is below minimum; clamping to %u", log_level);
-        zmod_config_mgr_set_value(CFG_LOG_LEVEL, &log_level, sizeof(log_level));
+        for (size_t i = 0U; i < out; i++) {
+            shell_fprintf(sh, SHELL_VT100_COLOR_DEFAULT, "%02x", buffer[i]);
+        }
+        shell_fprintf(sh, SHELL_VT100_COLOR_DEFAULT, "\n");
     }
 
-    uint32_t source_count = log_src_cnt_get(Z_LOG_LOCAL_DOMAIN_ID);
-    uint32_t set_count = 0;
-
-    for (uint32_t source_id = 0; source_id < source_count; source_id++) {
-        uint32_t result_level = log_filter_set(NULL, Z_LOG_LOCAL_DOMAIN_ID, source_id, log_level);
-        if (result_level == log_level) {
-            set_count++;
-        }
+    if (ret == -ENOENT) {
+        ret = 0;
+    } else {
+        shell_error(sh, "Failed to read log entry: %d", ret);
     }
 
-    LOG_INF("Log level initialized: %u (applied to %u/%u modules)", log_level, set_count, source_count);
+    zmod_log_storage_cursor_close(cursor);
+    return ret;
 }
 
-int zmod_log_storage_set_log_level(uint8_t level)
+#ifdef CONFIG_ZMOD_LOG_STORAGE_COMPRESSION
+/**
+ * @brief Shell command handler that measures LZ4 ratio and CPU cost on stored logs.
+ *
+ * Every stored payload is expanded (timing the decoder on LZ4 containers) and
+ * recompressed in the same block size the flusher uses.
+ */
+static int prv_shell_log_storage_compress_bench(const struct shell *sh, size_t argc, char **argv)
 {
-    if (level > LOG_LEVEL_DBG) {
-        LOG_ERR("Invalid log level: %u. Valid levels: %u=ERR, %u=WRN, %u=INF, %u=DBG",
-                level,
-                LOG_LEVEL_ERR,
-                LOG_LEVEL_WRN,
-                LOG_LEVEL_INF,
-                LOG_LEVEL_DBG);
-        return -EINVAL;
-    }
+    ARG_UNUSED(argc);
+    ARG_UNUSED(argv);
 
-    uint8_t clamped_level = level;
-    if (clamped_level < LOG_RUNTIME_MIN_LEVEL) {
-        clamped_level = LOG_RUNTIME_MIN_LEVEL;
+    struct fcb_entry entry = {0};
+    uint64_t raw_bytes = 0U;
+    uint64_t comp_bytes = 0U;
+    uint64_t comp_cycles = 0U;
+    uint64_t decomp_bytes = 0U;
+    uint64_t decomp_cycles = 0U;
+    uint32_t entries = 0U;
+
+    int ret = prv_lock();
+    if (ret < 0) {
+        shell_error(sh, "Unable to lock log storage: %d", ret);
+        return ret;
     }
 
-    uint32_t source_count = log_src_cnt_get(Z_LOG_LOCAL_DOMAIN_ID);
+    /* Close the open container while holding the mutex so the compressor state is free to borrow. */
+    (void)prv_staging_flush(true);
 
-    for (uint32_t source_id = 0; source_id < source_count; source_id++) {
-        log_filter_set(NULL, Z_LOG_LOCAL_DOMAIN_ID, source_id, clamped_level);
-    }
+    ret = fcb_getnext(&prv_inst.fcb_inst, &entry);
+    while (ret >= 0) {
+        prv_entry_info_t info;
 
-    if (!zmod_config_mgr_set_value(CFG_LOG_LEVEL, &clamped_level, sizeof(clamped_level))) {
-        LOG_ERR("Failed to save log level to config");
-        return -EIO;
+        prv_inst.decomp_valid = false;
+        uint32_t start = k_cycle_get_32();
+
+        ret = prv_entry_payload(&entry, &info);
+        uint32_t spent = k_cycle_get_32() - start;
+
+        if (ret < 0) {
+            shell_error(sh, "Failed to read log entry: %d", ret);
+            goto out;
+        }
+
+        if ((info.flags & LOG_STORAGE_CONTAINER_FLAG_LZ4) != 0U) {
+            decomp_cycles += spent;
+            decomp_bytes += info.len;
+        } else {
+            ret = prv_entry_read(&entry, &info, 0U, prv_inst.decomp_buf, info.len);
+            if (ret < 0) {
+                shell_error(sh, "Failed to read log entry: %d", ret);
+                goto out;
+            }
+        }
+        prv_inst.decomp_valid = false;
+
+        (void)LZ4_initStream(&prv_inst.lz4_stream, sizeof(prv_inst.lz4_stream));
+
+        for (uint16_t off = 0U; off < info.len; off += LOG_STORAGE_COMPRESS_BLOCK) {
+            int len = MIN(LOG_STORAGE_COMPRESS_BLOCK, info.len - off);
+
+            start = k_cycle_get_32();
+            int comp_len = LZ4_compress_fast_continue(&prv_inst.lz4_stream,
+                                                      (const char *)&prv_inst.decomp_buf[off],
+                                                      (char *)prv_inst.decomp_scratch,
+                                                      len,
+                                                      sizeof(prv_inst.decomp_scratch),
+                                                      1);
+            comp_cycles += k_cycle_get_32() - start;
+            comp_bytes += LOG_STORAGE_COMPRESS_BLOCK_HDR + MAX(comp_len, 0);
+        }
+
+        raw_bytes += info.len;
+        entries++;
+        ret = fcb_getnext(&prv_inst.fcb_inst, &entry);
     }
 
-    if (clamped_level != level) {
-        LOG_WRN("Requested level %u clamped to minimum runtime level %u", level, clamped_level);
+    if (ret == -ENOENT) {
+        ret = 0;
     }
 
-    const char *level_name = prv_get_log_level_name(clamped_level);
-    LOG_INF("Log level set to: %s (%u)", level_name, clamped_level);
+    shell_print(sh, "Entries: %u", entries);
 
-    return 0;
-}
+    if ((raw_bytes > 0U) && (comp_bytes > 0U)) {
+        uint32_t ratio = (uint32_t)((raw_bytes * 100U) / comp_bytes);
 
-#ifdef CONFIG_SHELL
+        shell_print(sh, "Raw: %u bytes, LZ4: %u bytes, ratio %u.%02u",
+                    (uint32_t)raw_bytes, (uint32_t)comp_bytes, ratio / 100U, ratio % 100U);
+        shell_print(sh, "Compress: %u us/KB",
+                    (uint32_t)((k_cyc_to_us_floor64(comp_cycles) * 1024U) / raw_bytes));
+    }
 
-#include <zephyr/shell/shell.h>
+    if (decomp_bytes > 0U) {
+        shell_print(sh, "Decompress (incl. flash read): %u us/KB",
+                    (uint32_t)((k_cyc_to_us_floor64(decomp_cycles) * 1024U) / decomp_bytes));
+    }
 
-/** @brief Shell command handler that reports export-in-progress state. */
-static int prv_shell_print_export_status(const struct shell *sh, size_t argc, char **argv)
-{
-    ARG_UNUSED(argc);
-    ARG_UNUSED(argv);
+    shell_print(sh, "Flusher since boot: %u -> %u bytes",
+                (uint32_t)prv_inst.raw_total, (uint32_t)prv_inst.compressed_total);
 
-    shell_print(sh, "Log export in progress: %s", prv_inst.export_in_progress ? "true" : "false");
-    return 0;
+out:
+    (void)LZ4_initStream(&prv_inst.lz4_stream, sizeof(prv_inst.lz4_stream));
+    k_mutex_unlock(&prv_inst.mutex);
+    return ret;
 }
+#endif
 
-/** @brief Shell command handler to erase all stored log entries. */
-static int prv_shell_log_storage_clear(const struct shell *sh, size_t argc, char **argv)
+/** @brief Shell command handler that prints storage counters since boot. */
+static int prv_shell_log_storage_stats(const struct shell *sh, size_t argc, char **argv)
 {
     ARG_UNUSED(argc);
     ARG_UNUSED(argv);
 
-    shell_print(sh, "Clearing stored logs...");
-
-    int ret = zmod_log_storage_clear();
+    zmod_log_storage_stats_t stats;
+    uint32_t erases[LOG_STORAGE_NUM_SECTORS];
 
+    int ret = zmod_log_storage_get_stats(&stats);
     if (ret < 0) {
-        shell_error(sh, "Failed to clear logs: %d", ret);
+        shell_error(sh, "Unable to read stats: %d", ret);
         return ret;
     }
 
-    shell_print(sh, "Stored logs cleared.");
+    size_t sectors = zmod_log_storage_get_erase_counts(erases, ARRAY_SIZE(erases));
+
+    shell_print(sh, "Written:        %llu bytes in %u records", (unsigned long long)stats.bytes_written,
+                stats.records_written);
+    shell_print(sh, "Append latency: avg %u us, max %u us", stats.append_avg_us, stats.append_max_us);
+    shell_print(sh, "Rotations:      %u (%u sector erases)", stats.rotations, stats.erases);
+    shell_print(sh, "Fetched:        %llu bytes", (unsigned long long)stats.fetch_bytes);
+    shell_print(sh, "Mutex timeouts: %u", stats.mutex_timeouts);
+    shell_print(sh, "Export drops:   %u records", stats.export_dropped_records);
+    shell_print(sh, "Ring full:      %u records, %u bytes", stats.drops.ring_full_records,
+                stats.drops.ring_full_bytes);
+    shell_print(sh, "Write failures: %u bytes", stats.drops.write_failed_bytes);
+    shell_print(sh, "Panic overflow: %u bytes", stats.drops.panic_full_bytes);
+
+    shell_fprintf(sh, SHELL_VT100_COLOR_DEFAULT, "Erases per sector:");
+    for (size_t i = 0U; i < sectors; i++) {
+        shell_fprintf(sh, SHELL_VT100_COLOR_DEFAULT, " %u", erases[i]);
+    }
+    shell_fprintf(sh, SHELL_VT100_COLOR_DEFAULT, "\n");
+
     return 0;
 }
 
-/** @brief Shell command handler that streams stored logs to the shell. */
-static int prv_shell_log_storage_export(const struct shell *sh, size_t argc, char **argv)
+#ifdef CONFIG_ZMOD_LOG_STORAGE_WEAR
+/** @brief Shell command handler that prints lifetime erase counts, budget and projected lifetime. */
+static int prv_shell_log_storage_wear(const struct shell *sh, size_t argc, char **argv)
 {
     ARG_UNUSED(argc);
     ARG_UNUSED(argv);
 
-    uint8_t buffer[64];
-    struct fcb_entry entry = {0};
-    bool previous_export_state = prv_inst.export_in_progress;
+    struct zmod_log_storage_wear_event wear;
+    uint32_t erases[LOG_STORAGE_NUM_SECTORS];
 
-    int ret = k_mutex_lock(&prv_inst.mutex, K_MSEC(LOG_STORAGE_MUTEX_TIMEOUT_MS));
+    int ret = zmod_log_storage_get_wear(&wear);
     if (ret < 0) {
-        shell_error(sh, "Unable to lock log storage: %d", ret);
+        shell_error(sh, "Unable to read wear: %d", ret);
         return ret;
     }
 
-    prv_inst.export_in_progress = true;
+    size_t sectors = zmod_log_storage_get_wear_counts(erases, ARRAY_SIZE(erases));
 
-    ret = fcb_getnext(&prv_inst.fcb_inst, &entry);
-    if (ret == -ENOENT) {
-        shell_print(sh, "No stored log entries.");
-        ret = 0;
-        goto out;
+    shell_print(sh, "Erases:         %u total, most worn sector %u of %u rated", wear.total_erases, wear.max_erases,
+                LOG_STORAGE_WEAR_ENDURANCE);
+    shell_print(sh, "Powered time:   %u h", wear.uptime_s / 3600U);
+    if (wear.lifetime_days == UINT32_MAX) {
+        shell_print(sh, "Lifetime:       unknown (no erases yet)");
+    } else {
+        shell_print(sh, "Lifetime:       %u days left at the average erase rate", wear.lifetime_days);
     }
-
-    while (ret >= 0) {
-        uint32_t offset = FCB_ENTRY_FA_DATA_OFF(entry);
-        uint16_t remaining = entry.fe_data_len;
-        uint32_t pos = 0U;
-
-        while (remaining > 0U) {
-            uint16_t chunk = MIN((uint16_t)sizeof(buffer), remaining);
-            int read_rc = flash_area_read(prv_inst.fa, offset + pos, buffer, chunk);
-            if (read_rc < 0) {
-                shell_error(sh, "Failed to read log entry: %d", read_rc);
-                ret = read_rc;
-                goto out;
-            }
-
-            char out_chunk[sizeof(buffer) + 1];
-            memcpy(out_chunk, buffer, chunk);
-            out_chunk[chunk] = '\0';
-            shell_fprintf(sh, SHELL_VT100_COLOR_DEFAULT, "%s", out_chunk);
-            remaining -= chunk;
-            pos += chunk;
-        }
-
-        ret = fcb_getnext(&prv_inst.fcb_inst, &entry);
+    if (LOG_STORAGE_WEAR_BUDGET > 0U) {
+        shell_print(sh, "Budget:         %u of %u erases today", wear.window_erases, LOG_STORAGE_WEAR_BUDGET);
+    } else {
+        shell_print(sh, "Budget:         none (%u erases today)", wear.window_erases);
+    }
+    if (wear.throttle_level != 0U) {
+        shell_print(sh, "Throttle:       storing %s and above, %u messages dropped",
+                    prv_get_log_level_name(wear.throttle_level), wear.dropped);
+    } else {
+        shell_print(sh, "Throttle:       off, %u messages dropped", wear.dropped);
     }
 
-    if (ret == -ENOENT) {
-        ret = 0;
+    shell_fprintf(sh, SHELL_VT100_COLOR_DEFAULT, "Lifetime erases per sector:");
+    for (size_t i = 0U; i < sectors; i++) {
+        shell_fprintf(sh, SHELL_VT100_COLOR_DEFAULT, " %u", erases[i]);
     }
+    shell_fprintf(sh, SHELL_VT100_COLOR_DEFAULT, "\n");
 
-out:
-    prv_inst.export_in_progress = previous_export_state;
-    k_mutex_unlock(&prv_inst.mutex);
-    return ret;
+    return 0;
 }
+#endif
 
 /** @brief Print a table of compiled and runtime log levels for each module. */
 static int prv_shell_list_module_log_levels(const struct shell *sh)
@@ -501,25 +4073,31 @@ static int prv_shell_list_module_log_levels(const struct shell *sh)
     uint32_t source_count = log_src_cnt_get(Z_LOG_LOCAL_DOMAIN_ID);
 
     shell_print(sh, "Module Log Levels (%u modules):", source_count);
-    shell_print(sh, "%-24s %-8s %-8s", "Module", "Runtime", "Compiled");
-    shell_print(sh, "%-24s %-8s %-8s", "------", "-------", "--------");
+    shell_print(sh, "%-24s %-8s %-8s %-8s", "Module", "Runtime", "Storage", "Compiled");
+    shell_print(sh, "%-24s %-8s %-8s %-8s", "------", "-------", "-------", "--------");
 
     for (uint32_t source_id = 0; source_id < source_count; source_id++) {
         const char *source_name = log_source_name_get(Z_LOG_LOCAL_DOMAIN_ID, source_id);
         uint32_t runtime_level = log_filter_get(NULL, Z_LOG_LOCAL_DOMAIN_ID, source_id, true);
         uint32_t compiled_level = log_filter_get(NULL, Z_LOG_LOCAL_DOMAIN_ID, source_id, false);
+        uint32_t storage_level = log_filter_get(zmod_flash_log_backend_get(), Z_LOG_LOCAL_DOMAIN_ID, source_id, true);
 
         const char *runtime_name = prv_get_log_level_name(runtime_level);
+        const char *storage_name = prv_get_log_level_name(storage_level);
         const char *compiled_name = prv_get_log_level_name(compiled_level);
 
         shell_print(sh,
-                    "%-24s %-8s %-8s",
+                    "%-24s %-8s %-8s %-8s",
                     source_name ? source_name : "unknown",
                     runtime_name,
+                    storage_name,
                     compiled_name);
     }
 
     shell_print(sh, "\nUse 'log_storage set_log_level <level>' to change runtime levels for all modules.");
+#ifdef CONFIG_ZMOD_LOG_STORAGE_BACKEND_FILTER
+    shell_print(sh, "Use 'log_storage set_storage_level <level> [module]' to change what is stored.");
+#endif
 
     return 0;
 }
@@ -539,6 +4117,27 @@ static int prv_shell_log_storage_list_levels(const struct shell *sh, size_t argc
     return prv_shell_list_module_log_levels(sh);
 }
 
+/** @brief Parse a severity name or number from a shell argument. */
+static int prv_shell_parse_level(const struct shell *sh, const char *arg, uint8_t *level)
+{
+    const prv_log_level_entry_t *entry = prv_find_log_level(arg);
+
+    if (entry != NULL) {
+        *level = entry->level;
+        return 0;
+    }
+
+    char *endptr = NULL;
+    long numeric = strtol(arg, &endptr, 10);
+    if ((endptr == NULL) || (*endptr != '\0') || numeric < LOG_RUNTIME_MIN_LEVEL || numeric > LOG_LEVEL_DBG) {
+        shell_error(sh, "Invalid level '%s'. Use one of: err, wrn, inf, dbg, or 1-4.", arg);
+        return -EINVAL;
+    }
+
+    *level = (uint8_t)numeric;
+    return 0;
+}
+
 /** @brief Shell command handler for updating the runtime log level. */
 static int prv_shell_log_storage_set_level_cmd(const struct shell *sh, size_t argc, char **argv)
 {
@@ -548,18 +4147,9 @@ static int prv_shell_log_storage_set_level_cmd(const struct shell *sh, size_t ar
     }
 
     uint8_t level;
-    const prv_log_level_entry_t *entry = prv_find_log_level(argv[1]);
 
-    if (entry != NULL) {
-        level = entry->level;
-    } else {
-        char *endptr = NULL;
-        long numeric = strtol(argv[1], &endptr, 10);
-        if ((endptr == NULL) || (*endptr != '\0') || numeric < LOG_RUNTIME_MIN_LEVEL || numeric > LOG_LEVEL_DBG) {
-            shell_error(sh, "Invalid level '%s'. Use one of: err, wrn, inf, dbg, or 1-4.", argv[1]);
-            return -EINVAL;
-        }
-        level = (uint8_t)numeric;
+    if (prv_shell_parse_level(sh, argv[1], &level) < 0) {
+        return -EINVAL;
     }
 
     int ret = zmod_log_storage_set_log_level(level);
@@ -574,6 +4164,38 @@ static int prv_shell_log_storage_set_level_cmd(const struct shell *sh, size_t ar
     return 0;
 }
 
+#ifdef CONFIG_ZMOD_LOG_STORAGE_BACKEND_FILTER
+/** @brief Shell command handler for updating what the flash backend stores. */
+static int prv_shell_log_storage_set_storage_level_cmd(const struct shell *sh, size_t argc, char **argv)
+{
+    uint8_t level;
+
+    if (prv_shell_parse_level(sh, argv[1], &level) < 0) {
+        return -EINVAL;
+    }
+
+    const char *source = (argc > 2) ? argv[2] : NULL;
+    int ret = zmod_log_storage_set_storage_level(source, level);
+
+    if (ret == -ENOENT) {
+        shell_error(sh, "Unknown module '%s'", source);
+        return ret;
+    }
+    if (ret == -ENOMEM) {
+        shell_error(sh, "Storage filter table is full; reset it with 'set_storage_level <level>'");
+        return ret;
+    }
+    if (ret < 0) {
+        shell_error(sh, "Failed to set storage level: %d", ret);
+        return ret;
+    }
+
+    shell_print(sh, "Storage level for %s set to %s.", (source != NULL) ? source : "all modules",
+                prv_get_log_level_name(MAX(level, LOG_RUNTIME_MIN_LEVEL)));
+    return 0;
+}
+#endif
+
 SHELL_STATIC_SUBCMD_SET_CREATE(log_storage_cmds,
                                SHELL_CMD_ARG(export_status,
                                              NULL,
@@ -593,12 +4215,73 @@ SHELL_STATIC_SUBCMD_SET_CREATE(log_storage_cmds,
                                              0),
                                SHELL_CMD_ARG(export,
                                              NULL,
-                                             "Stream stored log entries as plain text.\n"
+                                             "Stream stored log entries as plain text\n"
+                                             "(hex lines in dictionary format), optionally\n"
+                                             "limited to a log-clock window in ms. A negative\n"
+                                             "--since counts back from the newest entry.\n"
+                                             "Windows need CONFIG_ZMOD_LOG_STORAGE_STAGING, and a\n"
+                                             "negative --since also CONFIG_ZMOD_LOG_STORAGE_TIME_INDEX.\n"
                                              "usage:\n"
-                                             "$ log_storage export\n",
+                                             "$ log_storage export [--since <ms>] [--until <ms>]\n"
+                                             "$ log_storage export --since -600000\n",
                                              prv_shell_log_storage_export,
                                              1,
+                                             4),
+                               SHELL_COND_CMD_ARG(CONFIG_ZMOD_LOG_STORAGE_PRIORITY_TIER,
+                                                  export_priority,
+                                                  NULL,
+                                                  "Stream the high-severity tier, same options as export.\n"
+                                                  "usage:\n"
+                                                  "$ log_storage export_priority [--since <ms>] [--until <ms>]\n",
+                                                  prv_shell_log_storage_export_priority,
+                                                  1,
+                                                  4),
+                               SHELL_COND_CMD_ARG(CONFIG_ZMOD_LOG_STORAGE_TAIL,
+                                                  tail,
+                                                  NULL,
+                                                  "Stream the newest <n> log records (one per stored\n"
+                                                  "message; staged ones round out to whole containers),\n"
+                                                  "or with -b the newest <n> bytes.\n"
+                                                  "usage:\n"
+                                                  "$ log_storage tail [-b] <n>\n",
+                                                  prv_shell_log_storage_tail,
+                                                  2,
+                                                  1),
+                               SHELL_CMD_ARG(export_raw,
+                                             NULL,
+                                             "Dump stored entries verbatim as hex, compressed\n"
+                                             "containers included, for scripts/log_raw_decode.py.\n"
+                                             "usage:\n"
+                                             "$ log_storage export_raw\n",
+                                             prv_shell_log_storage_export_raw,
+                                             1,
+                                             0),
+                               SHELL_COND_CMD_ARG(CONFIG_ZMOD_LOG_STORAGE_COMPRESSION,
+                                                  compress_bench,
+                                                  NULL,
+                                                  "Measure LZ4 ratio and CPU cost per KB on stored logs.\n"
+                                                  "usage:\n"
+                                                  "$ log_storage compress_bench\n",
+                                                  prv_shell_log_storage_compress_bench,
+                                                  1,
+                                                  0),
+                               SHELL_CMD_ARG(stats,
+                                             NULL,
+                                             "Show write, erase, latency and drop counters since boot.\n"
+                                             "usage:\n"
+                                             "$ log_storage stats\n",
+                                             prv_shell_log_storage_stats,
+                                             1,
                                              0),
+                               SHELL_COND_CMD_ARG(CONFIG_ZMOD_LOG_STORAGE_WEAR,
+                                                  wear,
+                                                  NULL,
+                                                  "Show lifetime erase counts, erase budget and projected lifetime.\n"
+                                                  "usage:\n"
+                                                  "$ log_storage wear\n",
+                                                  prv_shell_log_storage_wear,
+                                                  1,
+                                                  0),
                                SHELL_CMD_ARG(list_log_levels,
                                              NULL,
                                              "List current module log levels and available severities.\n"
@@ -615,6 +4298,16 @@ SHELL_STATIC_SUBCMD_SET_CREATE(log_storage_cmds,
                                              prv_shell_log_storage_set_level_cmd,
                                              2,
                                              0),
+                               SHELL_COND_CMD_ARG(CONFIG_ZMOD_LOG_STORAGE_BACKEND_FILTER,
+                                                  set_storage_level,
+                                                  NULL,
+                                                  "Set the level stored to flash, for one module or all.\n"
+                                                  "Setting all modules drops per-module overrides.\n"
+                                                  "usage:\n"
+                                                  "$ log_storage set_storage_level <err|wrn|inf|dbg|1-4> [module]\n",
+                                                  prv_shell_log_storage_set_storage_level_cmd,
+                                                  2,
+                                                  1),
                                SHELL_SUBCMD_SET_END);
 
 SHELL_CMD_REGISTER(log_storage, &log_storage_cmds, "Log storage commands", NULL);